@@ -0,0 +1,306 @@
+// Copyright 2014-2015 Martin Moene.
+//
+// Use, modification, and distribution is subject to the Boost Software
+// License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// bench_clamp - measure clamp() and clamp_range() across element types, sizes
+// and input distributions.
+//
+// Usage: bench_clamp [--quick] [--max-bytes=N] [--type=name] [--dist=name]
+//
+// For each element type, input size (from L1-sized up to --max-bytes per
+// buffer) and distribution of the input relative to [lo, hi] it reports:
+// - clamp_range(): throughput in elements/s and bytes/s (input bytes), and
+//   the time per call;
+// - clamp() and clamp_value(): time per call in a loop over the same input;
+// - clamp_range() with clamp_store::cached and clamp_store::streaming, and
+//   std::transform() with clamp_value(): throughput in bytes/s. Streaming
+//   stores pay off when the output is much larger than the last-level cache;
+// - clamp_range() with std::move_iterator input, moving the values between two
+//   buffers: throughput in bytes/s. After the first call all values are in
+//   range, so this measures moving values that need no clamping, which for an
+//   expensive-to-copy type such as text is much cheaper than copying them.
+// The distribution matters as much as the size: with data that is all in
+// range, all below or all above, the comparisons in clamp() are perfectly
+// predictable, with random data they are not.
+
+#if __cplusplus < 201103L
+#error Compile as C++11 or newer.
+#else // __cplusplus < 201103L
+
+#include "clamp.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// heavy copyable type, ordered by key:
+
+struct heavy
+{
+    heavy( int key = 0 ) : key( key ) { std::fill( payload, payload + 15, key ); }
+
+    int key;
+    int payload[15];
+};
+
+bool operator<( heavy const & lhs, heavy const & rhs ) { return lhs.key < rhs.key; }
+
+long long checksum_of( heavy const & x ) { return x.key; }
+
+// expensive-to-copy, cheap-to-move type, ordered by key; the payload is too
+// long for the small string optimization, so a copy allocates:
+
+struct text
+{
+    text( int key = 0 ) : key( key ), payload( 48, char( 'a' + ( key & 15 ) ) ) {}
+
+    int key;
+    std::string payload;
+};
+
+bool operator<( text const & lhs, text const & rhs ) { return lhs.key < rhs.key; }
+
+long long checksum_of( text const & x ) { return x.key + static_cast<long long>( x.payload.size() ); }
+
+template< typename T >
+long long checksum_of( T const & x ) { return static_cast<long long>( x ); }
+
+// command line options:
+
+struct options
+{
+    bool quick = false;
+    std::size_t max_bytes = 256u << 20;
+    std::string type;
+    std::string dist;
+};
+
+char const * const distributions[] = { "in_range", "below", "above", "random", "sorted", };
+
+// input of n elements in [-100, 100), with lo = -50, hi = 50:
+
+template< typename T >
+std::vector<T> make_input( std::size_t n, std::string const & dist )
+{
+    std::mt19937 gen( 42 );
+    std::uniform_int_distribution<int> in_range( -49, 49 ), below( -100, -51 ), above( 51, 99 ), all( -100, 99 );
+
+    std::vector<T> v; v.reserve( n );
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        int const x = dist == "in_range" ? in_range( gen ) :
+                      dist == "below"    ? below( gen ) :
+                      dist == "above"    ? above( gen ) : all( gen );
+        v.push_back( T( x ) );
+    }
+
+    if ( dist == "sorted" )
+        std::sort( v.begin(), v.end() );
+
+    return v;
+}
+
+// signed types use [-50, 50]; unsigned types see the same pattern shifted by
+// 100 and use [50, 150]:
+
+template< typename T >
+std::vector<T> make_input( std::size_t n, std::string const & dist, std::false_type /*unsigned*/ )
+{
+    std::vector<int> const s = make_input<int>( n, dist );
+    std::vector<T> v; v.reserve( n );
+    for ( int x : s ) v.push_back( static_cast<T>( x + 100 ) );
+    return v;
+}
+
+template< typename T >
+std::vector<T> make_input( std::size_t n, std::string const & dist, std::true_type /*signed*/ )
+{
+    return make_input<T>( n, dist );
+}
+
+template< typename T > T bound_lo() { return T( std::is_unsigned<T>::value ?  50 : -50 ); }
+template< typename T > T bound_hi() { return T( std::is_unsigned<T>::value ? 150 :  50 ); }
+
+// seconds per call of f(), best of several runs of at least 20 ms each:
+
+template< typename F >
+double seconds_per_call( F f )
+{
+    typedef std::chrono::steady_clock clock;
+
+    double best = 1e9;
+
+    for ( int run = 0; run < 5; ++run )
+    {
+        long calls = 0;
+        auto const start = clock::now();
+        double elapsed = 0;
+
+        do
+        {
+            f(); ++calls;
+            elapsed = std::chrono::duration<double>( clock::now() - start ).count();
+        }
+        while ( elapsed < 0.02 );
+
+        best = std::min( best, elapsed / calls );
+    }
+    return best;
+}
+
+long long sink = 0;
+
+template< typename T >
+T opaque( T const & x )
+{
+    static T volatile const * volatile p = nullptr;
+    T const * const q = &x;
+    return *( p ? const_cast<T const *>( p ) : q );
+}
+
+template< typename T >
+void bench( char const * name, options const & opt )
+{
+    if ( !opt.type.empty() && opt.type != name )
+        return;
+
+    std::size_t const max_bytes = opt.quick ? std::min<std::size_t>( opt.max_bytes, 1u << 20 ) : opt.max_bytes;
+
+    for ( char const * dist : distributions )
+    {
+        if ( !opt.dist.empty() && opt.dist != dist )
+            continue;
+
+        for ( std::size_t bytes = 16u << 10; bytes <= max_bytes; bytes *= 4 )
+        {
+            std::size_t const n = bytes / sizeof( T );
+
+            std::vector<T> const in = make_input<T>( n, dist,
+                std::integral_constant<bool, !std::is_unsigned<T>::value>() );
+            std::vector<T> out( n );
+
+            // keep the compiler from folding the bounds into the loops:
+            T const lo = opaque( bound_lo<T>() );
+            T const hi = opaque( bound_hi<T>() );
+
+            double const range_s = seconds_per_call( [&]
+            {
+                clamp_range( in.begin(), in.end(), out.begin(), lo, hi );
+                sink += checksum_of( out[ n / 2 ] );
+            });
+
+            double const cached_s = seconds_per_call( [&]
+            {
+                clamp_range( clamp_store::cached, in.begin(), in.end(), out.begin(), lo, hi );
+                sink += checksum_of( out[ n / 2 ] );
+            });
+
+            double const streaming_s = seconds_per_call( [&]
+            {
+                clamp_range( clamp_store::streaming, in.begin(), in.end(), out.begin(), lo, hi );
+                sink += checksum_of( out[ n / 2 ] );
+            });
+
+            double const transform_s = seconds_per_call( [&]
+            {
+                std::transform( in.begin(), in.end(), out.begin(), [&]( T const & x ) { return clamp_value( x, lo, hi ); } );
+                sink += checksum_of( out[ n / 2 ] );
+            });
+
+            double const scalar_s = seconds_per_call( [&]
+            {
+                for ( std::size_t i = 0; i != n; ++i )
+                    out[i] = clamp( in[i], lo, hi );
+                sink += checksum_of( out[ n / 2 ] );
+            });
+
+            double const value_s = seconds_per_call( [&]
+            {
+                for ( std::size_t i = 0; i != n; ++i )
+                    out[i] = clamp_value( in[i], lo, hi );
+                sink += checksum_of( out[ n / 2 ] );
+            });
+
+            std::vector<T> ping( in ), pong( n );
+
+            double const move_s = seconds_per_call( [&]
+            {
+                clamp_range( std::make_move_iterator( ping.begin() ), std::make_move_iterator( ping.end() ), pong.begin(), lo, hi );
+                ping.swap( pong );
+                sink += checksum_of( ping[ n / 2 ] );
+            });
+
+            std::printf( "%-8s %-8s %9zu KiB %10.3f Gelem/s %8.2f GB/s %12.1f ns/range %8.3f ns/clamp %8.3f ns/clamp_value"
+                " %8.2f GB/s cached %8.2f GB/s streaming %8.2f GB/s transform %8.2f GB/s move\n",
+                name, dist, bytes >> 10,
+                n / range_s * 1e-9, bytes / range_s * 1e-9, range_s * 1e9, scalar_s / n * 1e9, value_s / n * 1e9,
+                bytes / cached_s * 1e-9, bytes / streaming_s * 1e-9, bytes / transform_s * 1e-9, bytes / move_s * 1e-9 );
+        }
+    }
+}
+
+options parse( int argc, char * argv[] )
+{
+    options opt;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        std::string const arg = argv[i];
+
+        if      ( arg == "--quick"                   ) opt.quick = true;
+        else if ( arg.compare( 0, 12, "--max-bytes=" ) == 0 ) opt.max_bytes = std::strtoull( arg.c_str() + 12, nullptr, 0 );
+        else if ( arg.compare( 0,  7, "--type="      ) == 0 ) opt.type = arg.substr( 7 );
+        else if ( arg.compare( 0,  7, "--dist="      ) == 0 ) opt.dist = arg.substr( 7 );
+        else
+        {
+            std::fprintf( stderr, "Usage: %s [--quick] [--max-bytes=N] [--type=name] [--dist=name]\n", argv[0] );
+            std::exit( EXIT_FAILURE );
+        }
+    }
+    return opt;
+}
+
+} // anonymous namespace
+
+int main( int argc, char * argv[] )
+{
+    options const opt = parse( argc, argv );
+
+    bench<std::int8_t  >( "int8"  , opt );
+    bench<std::uint8_t >( "uint8" , opt );
+    bench<std::int16_t >( "int16" , opt );
+    bench<std::uint16_t>( "uint16", opt );
+    bench<std::int32_t >( "int32" , opt );
+    bench<std::uint32_t>( "uint32", opt );
+    bench<std::int64_t >( "int64" , opt );
+    bench<std::uint64_t>( "uint64", opt );
+    bench<float        >( "float" , opt );
+    bench<double       >( "double", opt );
+    bench<clamp_half    >( "half"    , opt );
+    bench<clamp_bfloat16>( "bfloat16", opt );
+    bench<heavy        >( "heavy" , opt );
+
+    // each text value owns a heap allocation besides its sizeof(text) bytes:
+    options text_opt = opt;
+    text_opt.max_bytes = std::min<std::size_t>( opt.max_bytes, 16u << 20 );
+
+    bench<text         >( "text"  , text_opt );
+
+    return sink == 42 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+#endif //__cplusplus < 201103L
+
+// g++ -Wall -std=c++11 -pthread -O2 -o bench_clamp bench_clamp.cpp && bench_clamp
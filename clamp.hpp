@@ -12,8 +12,82 @@
 
 #include "std14.hpp"
 
-#include <iterator>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <ostream>
+#include <ratio>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Ranges of at least CLAMP_PARALLEL_THRESHOLD elements are split across
+// threads by the parallel clamp_range() overloads.
+
+#ifndef CLAMP_PARALLEL_THRESHOLD
+# define CLAMP_PARALLEL_THRESHOLD  ( 128 * 1024 )
+#endif
+
+// The parallel overloads use a thread pool of CLAMP_THREAD_POOL_SIZE workers
+// plus the calling thread; 0 selects std::thread::hardware_concurrency() - 1.
+
+#ifndef CLAMP_THREAD_POOL_SIZE
+# define CLAMP_THREAD_POOL_SIZE  0
+#endif
+
+// Out-of-place clamp_range() of contiguous arithmetic data of at least
+// CLAMP_STREAMING_THRESHOLD bytes, about the size of the last-level cache,
+// uses non-temporal stores; 0 disables automatic streaming.
+
+#ifndef CLAMP_STREAMING_THRESHOLD
+# define CLAMP_STREAMING_THRESHOLD  ( 32 * 1024 * 1024 )
+#endif
+
+// SIMD support is selected at compile time from the target instruction set,
+// e.g. -msse4.1, -mavx2 or -mavx512bw (g++, clang), /arch:AVX2 (VC).
+// Define CLAMP_NO_SIMD to always use the generic std::transform() path.
+
+#if !defined( CLAMP_NO_SIMD )
+# if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#  define CLAMP_HAVE_SSE2  1
+#  include <emmintrin.h>
+# endif
+# if defined( __SSE4_1__ ) || ( defined( _MSC_VER ) && defined( __AVX__ ) )
+#  define CLAMP_HAVE_SSE41 1
+#  include <smmintrin.h>
+# endif
+# if defined( __AVX2__ )
+#  define CLAMP_HAVE_AVX2  1
+#  include <immintrin.h>
+# endif
+# if defined( __AVX512F__ )
+#  define CLAMP_HAVE_AVX512F  1
+#  include <immintrin.h>
+# endif
+# if defined( __AVX512BW__ )
+#  define CLAMP_HAVE_AVX512BW 1
+# endif
+# if defined( __F16C__ )
+#  define CLAMP_HAVE_F16C  1
+#  include <immintrin.h>
+# endif
+#endif
 
 // ---------------------------------------------------------------------------
 // Interface
@@ -23,6 +97,12 @@
 template<class T, class Compare = std14::less<>>
 constexpr const T& clamp( const T& val, const T& lo, const T& hi, Compare comp = Compare() );
 
+// clamp value per predicate, default std::less<>, returning a copy; for
+// arithmetic types this compiles to min/max (cmov, minsd/maxsd) sequences:
+
+template<class T, class Compare = std14::less<>>
+constexpr T clamp_value( const T& val, const T& lo, const T& hi, Compare comp = Compare() );
+
 // Boost also contains clamp_range():
 
 // clamp range of values per predicate, default std::less<>:
@@ -32,6 +112,535 @@ OutputIterator clamp_range( InputIterator first, InputIterator last, OutputItera
     typename std::iterator_traits<InputIterator>::value_type const& lo,
     typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp = Compare() );
 
+// execution policies, like C++17 std::execution:
+
+namespace clamp_execution {
+
+struct sequenced_policy {};
+struct parallel_policy {};
+struct parallel_unsequenced_policy {};
+
+constexpr sequenced_policy            seq{};
+constexpr parallel_policy             par{};
+constexpr parallel_unsequenced_policy par_unseq{};
+
+template<class T> struct is_execution_policy : std::false_type {};
+
+template<> struct is_execution_policy<sequenced_policy           > : std::true_type {};
+template<> struct is_execution_policy<parallel_policy            > : std::true_type {};
+template<> struct is_execution_policy<parallel_unsequenced_policy> : std::true_type {};
+
+template<class ExecutionPolicy, class R>
+struct enable_if_policy : std::enable_if<
+    is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, R> {};
+
+} // namespace clamp_execution
+
+// clamp range of values per predicate and execution policy, default std::less<>;
+// the parallel policies split random-access ranges across a thread pool:
+
+template<class ExecutionPolicy, class InputIterator, class OutputIterator, class Compare = std14::less<>>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, OutputIterator>::type
+clamp_range( ExecutionPolicy&& policy, InputIterator first, InputIterator last, OutputIterator out,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp = Compare() );
+
+// clamp value and range of values to compile-time bounds per std::less<>: as
+// integers, or as types with a constexpr static member value, such as
+// std::integral_constant, or as std::ratio, e.g. for floating point bounds.
+// The bounds must be representable in T, so a std::ratio bound for an
+// integral T must be a whole number; a bound that equals the limit of an
+// integral T costs nothing:
+
+template<std::intmax_t Lo, std::intmax_t Hi, class T>
+constexpr T clamp( T const& val );
+
+template<class Lo, class Hi, class T>
+constexpr T clamp( T const& val );
+
+template<std::intmax_t Lo, std::intmax_t Hi, class InputIterator, class OutputIterator>
+OutputIterator clamp_range( InputIterator first, InputIterator last, OutputIterator out );
+
+template<class Lo, class Hi, class InputIterator, class OutputIterator>
+OutputIterator clamp_range( InputIterator first, InputIterator last, OutputIterator out );
+
+// iterator that clamps the values of the underlying iterator on dereference
+// per predicate, default std::less<>; its iterator_category and
+// iterator_concept are the underlying iterator's category, whose operations
+// it provides, so that std::distance(), std::prev() and the algorithms keep
+// their complexity; it returns values, not references, and its pointer is
+// void, so the view is multi-pass, but &*it does not refer into the range:
+
+template<class Iterator, class Compare = std14::less<>>
+class clamp_iterator;
+
+// lazy view of a range of clamped values, see clamped_view():
+
+template<class Iterator, class Compare = std14::less<>>
+class clamp_view;
+
+// view of range of values, clamped on access per predicate, default
+// std::less<>, without storing the clamped values; the range must outlive the
+// view:
+
+template<class Range, class Compare = std14::less<>>
+clamp_view<decltype( std::begin( std::declval<Range&>() ) ), Compare>
+clamped_view( Range& range,
+    typename std::iterator_traits<decltype( std::begin( std::declval<Range&>() ) )>::value_type const& lo,
+    typename std::iterator_traits<decltype( std::begin( std::declval<Range&>() ) )>::value_type const& hi, Compare comp = Compare() );
+
+template<class Iterator, class Compare = std14::less<>>
+clamp_view<Iterator, Compare>
+clamped_view( Iterator first, Iterator last,
+    typename std::iterator_traits<Iterator>::value_type const& lo,
+    typename std::iterator_traits<Iterator>::value_type const& hi, Compare comp = Compare() );
+
+// output iterator that clamps each value assigned to it per predicate, default
+// std::less<>, and writes it to the underlying output iterator:
+
+template<class OutputIterator, class T, class Compare = std14::less<>>
+class clamp_output_iterator;
+
+template<class OutputIterator, class T, class Compare = std14::less<>>
+clamp_output_iterator<OutputIterator, T, Compare>
+make_clamp_output_iterator( OutputIterator out, T const& lo, T const& hi, Compare comp = Compare() );
+
+// copy range of values like std::copy(); to a clamp_output_iterator over
+// contiguous storage, clamp with the SIMD clamp_range() on the raw pointer:
+
+template<class InputIterator, class OutputIterator>
+OutputIterator clamp_copy( InputIterator first, InputIterator last, OutputIterator out );
+
+template<class InputIterator, class OutputIterator, class T, class Compare>
+clamp_output_iterator<OutputIterator, T, Compare>
+clamp_copy( InputIterator first, InputIterator last, clamp_output_iterator<OutputIterator, T, Compare> out );
+
+// NaN policies: propagate a NaN value (the default behaviour of clamp() with
+// std::less<>), map it to lo or to hi, or assume there is no NaN, which may
+// select the fastest kernel and leaves the result for NaN unspecified:
+
+namespace clamp_nan {
+
+struct propagate_policy {};
+struct to_lo_policy {};
+struct to_hi_policy {};
+struct assume_none_policy {};
+
+constexpr propagate_policy   propagate{};
+constexpr to_lo_policy       to_lo{};
+constexpr to_hi_policy       to_hi{};
+constexpr assume_none_policy assume_none{};
+
+template<class T> struct is_nan_policy : std::false_type {};
+
+template<> struct is_nan_policy<propagate_policy  > : std::true_type {};
+template<> struct is_nan_policy<to_lo_policy      > : std::true_type {};
+template<> struct is_nan_policy<to_hi_policy      > : std::true_type {};
+template<> struct is_nan_policy<assume_none_policy> : std::true_type {};
+
+template<class NanPolicy, class R>
+struct enable_if_policy : std::enable_if<
+    is_nan_policy<typename std::decay<NanPolicy>::type>::value, R> {};
+
+} // namespace clamp_nan
+
+// clamp value and range of values per NaN policy and predicate, default
+// std::less<>:
+
+template<class NanPolicy, class T, class Compare = std14::less<>>
+constexpr typename clamp_nan::enable_if_policy<NanPolicy, const T&>::type
+clamp( NanPolicy policy, const T& val, const T& lo, const T& hi, Compare comp = Compare() );
+
+template<class NanPolicy, class InputIterator, class OutputIterator, class Compare = std14::less<>>
+typename clamp_nan::enable_if_policy<NanPolicy, OutputIterator>::type
+clamp_range( NanPolicy policy, InputIterator first, InputIterator last, OutputIterator out,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp = Compare() );
+
+// store policies: clamp_range() selects non-temporal stores for large output
+// automatically, per CLAMP_STREAMING_THRESHOLD; cached always stores via the
+// cache, streaming always bypasses it with non-temporal stores and prefetches
+// the input, for output that is not read again soon; changed stores only the
+// values that change when clamping in place, so that memory that is already
+// in range is not dirtied, such as mapped files and copy-on-write pages:
+
+namespace clamp_store {
+
+struct automatic_policy {};
+struct cached_policy {};
+struct streaming_policy {};
+struct changed_policy {};
+
+constexpr automatic_policy automatic{};
+constexpr cached_policy    cached{};
+constexpr streaming_policy streaming{};
+constexpr changed_policy   changed{};
+
+template<class T> struct is_store_policy : std::false_type {};
+
+template<> struct is_store_policy<automatic_policy> : std::true_type {};
+template<> struct is_store_policy<cached_policy   > : std::true_type {};
+template<> struct is_store_policy<streaming_policy> : std::true_type {};
+template<> struct is_store_policy<changed_policy  > : std::true_type {};
+
+template<class StorePolicy, class R>
+struct enable_if_policy : std::enable_if<
+    is_store_policy<typename std::decay<StorePolicy>::type>::value, R> {};
+
+} // namespace clamp_store
+
+// clamp range of values per store policy and predicate, default std::less<>;
+// contiguous arithmetic data only, other ranges clamp like clamp_range():
+
+template<class StorePolicy, class InputIterator, class OutputIterator, class Compare = std14::less<>>
+typename clamp_store::enable_if_policy<StorePolicy, OutputIterator>::type
+clamp_range( StorePolicy policy, InputIterator first, InputIterator last, OutputIterator out,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp = Compare() );
+
+// convert arithmetic value to To, saturating at To's range; floating point
+// to integer truncates and converts NaN to 0, floating point to floating
+// point keeps infinities and NaN:
+
+template<class To, class From>
+constexpr To clamp_cast( From const& val );
+
+// convert range of values with clamp_cast<To>(), by default to the output's
+// value type:
+
+template<class To = void, class InputIterator, class OutputIterator>
+OutputIterator clamp_convert_range( InputIterator first, InputIterator last, OutputIterator out );
+
+// clamp binary stream of T values per predicate, default std::less<>, reading
+// the next chunk on a second thread while clamping and writing the current
+// one; returns the number of values written:
+
+template<class T, class Compare = std14::less<>>
+std::size_t clamp_stream( std::istream & in, std::ostream & out, T const& lo, T const& hi,
+    Compare comp = Compare(), std::size_t chunk_size = 256 * 1024 );
+
+// clamp range of values sorted per predicate, default std::less<>: binary
+// search for the values below lo and above hi, then fill, copy and fill; in
+// place, only the values that change are written, in O(log n) comparisons:
+
+template<class ForwardIterator, class OutputIterator, class Compare = std14::less<>>
+OutputIterator clamp_sorted_range( ForwardIterator first, ForwardIterator last, OutputIterator out,
+    typename std::iterator_traits<ForwardIterator>::value_type const& lo,
+    typename std::iterator_traits<ForwardIterator>::value_type const& hi, Compare comp = Compare() );
+
+// clamp range of values per predicate, default std::less<>, to per-element
+// bounds: lo and hi each are either a value for all elements or an iterator
+// to a range of bounds, one per element, like numpy's clip():
+
+template<class InputIterator, class OutputIterator, class Lo, class Hi, class Compare = std14::less<>>
+OutputIterator clamp_range_each( InputIterator first, InputIterator last, OutputIterator out,
+    Lo lo, Hi hi, Compare comp = Compare() );
+
+// result of clamp_range_count(): end of output, and the number of values that
+// were clamped to lo and to hi:
+
+template<class OutputIterator>
+struct clamp_count_result
+{
+    OutputIterator out;
+    std::size_t below;
+    std::size_t above;
+};
+
+// clamp range of values per predicate, default std::less<>, and count the
+// values below lo and above hi in the same pass:
+
+template<class InputIterator, class OutputIterator, class Compare = std14::less<>>
+clamp_count_result<OutputIterator> clamp_range_count( InputIterator first, InputIterator last, OutputIterator out,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp = Compare() );
+
+// reduce range of clamped values with op, starting from init, without storing
+// the clamped values; per predicate, default std::less<>:
+
+template<class InputIterator, class T, class BinaryOperation, class Compare = std14::less<>>
+T clamp_reduce( InputIterator first, InputIterator last,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, T init, BinaryOperation op, Compare comp = Compare() );
+
+// accumulator type of clamp_sum(): long double for long double, double for
+// other floating point types, clamp_half and clamp_bfloat16, (unsigned) long
+// long for integers:
+
+template<class T>
+struct clamp_sum_type
+{
+    typedef typename std::conditional< std::is_floating_point<T>::value,
+        typename std::conditional< std::is_same<T, long double>::value, long double, double >::type,
+        typename std::conditional< std::is_signed<T>::value, long long, unsigned long long >::type >::type type;
+};
+
+// sum, mean, minimum and maximum of range of clamped arithmetic, clamp_half
+// or clamp_bfloat16 values per predicate, default std::less<>; the mean of an
+// empty range is NaN, the minimum and maximum require a non-empty range:
+
+template<class InputIterator, class Compare = std14::less<>>
+typename clamp_sum_type<typename std::iterator_traits<InputIterator>::value_type>::type
+clamp_sum( InputIterator first, InputIterator last,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp = Compare() );
+
+template<class InputIterator, class Compare = std14::less<>>
+double clamp_mean( InputIterator first, InputIterator last,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp = Compare() );
+
+template<class InputIterator, class Compare = std14::less<>>
+typename std::iterator_traits<InputIterator>::value_type
+clamp_min( InputIterator first, InputIterator last,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp = Compare() );
+
+template<class InputIterator, class Compare = std14::less<>>
+typename std::iterator_traits<InputIterator>::value_type
+clamp_max( InputIterator first, InputIterator last,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp = Compare() );
+
+// sum and mean per execution policy; the parallel policies split random-access
+// ranges across the thread pool of the parallel clamp_range():
+
+template<class ExecutionPolicy, class InputIterator, class Compare = std14::less<>>
+typename clamp_execution::enable_if_policy<ExecutionPolicy,
+    typename clamp_sum_type<typename std::iterator_traits<InputIterator>::value_type>::type>::type
+clamp_sum( ExecutionPolicy&& policy, InputIterator first, InputIterator last,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp = Compare() );
+
+template<class ExecutionPolicy, class InputIterator, class Compare = std14::less<>>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, double>::type
+clamp_mean( ExecutionPolicy&& policy, InputIterator first, InputIterator last,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp = Compare() );
+
+// clamp range of N interleaved channels, such as RGBA pixels or xyz triplets,
+// to bounds per channel, per predicate, default std::less<>; the first element
+// is of channel 0:
+
+template<class InputIterator, class OutputIterator, std::size_t N, class Compare = std14::less<>>
+OutputIterator clamp_range_channels( InputIterator first, InputIterator last, OutputIterator out,
+    std::array<typename std::iterator_traits<InputIterator>::value_type, N> const& lo,
+    std::array<typename std::iterator_traits<InputIterator>::value_type, N> const& hi, Compare comp = Compare() );
+
+// 2D region of height rows of width elements of T, such as a region of interest
+// in an image or matrix: rows start pitch bytes apart, elements in a row are
+// stride elements apart:
+
+template<class T>
+struct pitched_view
+{
+    typedef typename std::remove_const<T>::type value_type;
+
+    T * base;
+    std::size_t width;
+    std::size_t height;
+    std::ptrdiff_t pitch;
+    std::ptrdiff_t stride;
+
+    operator pitched_view<T const>() const { return { base, width, height, pitch, stride }; }
+
+    T * row( std::size_t y ) const
+    {
+        typedef typename std::conditional< std::is_const<T>::value, char const, char >::type byte;
+        return reinterpret_cast<T *>( reinterpret_cast<byte *>( base ) + std::ptrdiff_t( y ) * pitch );
+    }
+};
+
+template<class T>
+pitched_view<T> make_pitched_view( T * base, std::size_t width, std::size_t height, std::ptrdiff_t pitch, std::ptrdiff_t stride = 1 );
+
+// clamp 2D region per predicate, default std::less<>, to a region of the same
+// size; for in place, pass the same view as in and out:
+
+template<class T, class Compare = std14::less<>>
+void clamp_range_2d( pitched_view<typename std::add_const<T>::type> in, pitched_view<T> out,
+    typename pitched_view<T>::value_type const& lo,
+    typename pitched_view<T>::value_type const& hi, Compare comp = Compare() );
+
+// clamp 2D region per execution policy; the parallel policies clamp blocks of
+// rows on the thread pool of the parallel clamp_range():
+
+template<class ExecutionPolicy, class T, class Compare = std14::less<>>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, void>::type
+clamp_range_2d( ExecutionPolicy&& policy, pitched_view<typename std::add_const<T>::type> in, pitched_view<T> out,
+    typename pitched_view<T>::value_type const& lo,
+    typename pitched_view<T>::value_type const& hi, Compare comp = Compare() );
+
+// range of a batch for clamp_range_batch(): clamp [first, last) to [lo, hi]
+// into out, which may equal first:
+
+template<class T>
+struct clamp_batch_item
+{
+    typedef T value_type;
+
+    T const * first;
+    T const * last;
+    T * out;
+    T lo;
+    T hi;
+};
+
+// clamp batch of independent ranges, each to its own bounds, per predicate,
+// default std::less<>, in one call. The output of a range must not overlap
+// the input or output of another range:
+
+template<class ForwardIterator, class Compare = std14::less<>>
+void clamp_range_batch( ForwardIterator first, ForwardIterator last, Compare comp = Compare() );
+
+// clamp batch per execution policy; the parallel policies clamp blocks of
+// ranges on the thread pool of the parallel clamp_range():
+
+template<class ExecutionPolicy, class ForwardIterator, class Compare = std14::less<>>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, void>::type
+clamp_range_batch( ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, Compare comp = Compare() );
+
+// clamp the values of random-access range first at the indices in
+// [index_first, index_last) in place, per predicate, default std::less<>:
+
+template<class RandomAccessIterator, class IndexIterator, class Compare = std14::less<>>
+void clamp_indexed( RandomAccessIterator first, IndexIterator index_first, IndexIterator index_last,
+    typename std::iterator_traits<RandomAccessIterator>::value_type const& lo,
+    typename std::iterator_traits<RandomAccessIterator>::value_type const& hi, Compare comp = Compare() );
+
+// gather: clamp the values of random-access range first at the indices in
+// [index_first, index_last) to out, in index order:
+
+template<class RandomAccessIterator, class IndexIterator, class OutputIterator, class Compare = std14::less<>>
+OutputIterator clamp_gather( RandomAccessIterator first, IndexIterator index_first, IndexIterator index_last, OutputIterator out,
+    typename std::iterator_traits<RandomAccessIterator>::value_type const& lo,
+    typename std::iterator_traits<RandomAccessIterator>::value_type const& hi, Compare comp = Compare() );
+
+// scatter: clamp range of values to random-access range out, the k-th value
+// to out[index_first[k]]; of equal indices, the last one wins:
+
+template<class InputIterator, class IndexIterator, class RandomAccessIterator, class Compare = std14::less<>>
+void clamp_scatter( InputIterator first, InputIterator last, IndexIterator index_first, RandomAccessIterator out,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp = Compare() );
+
+// indexed clamp, gather and scatter per execution policy; the parallel
+// policies split random-access index ranges across the thread pool of the
+// parallel clamp_range(). For clamp_indexed() and clamp_scatter(), the
+// indices must then be distinct:
+
+template<class ExecutionPolicy, class RandomAccessIterator, class IndexIterator, class Compare = std14::less<>>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, void>::type
+clamp_indexed( ExecutionPolicy&& policy, RandomAccessIterator first, IndexIterator index_first, IndexIterator index_last,
+    typename std::iterator_traits<RandomAccessIterator>::value_type const& lo,
+    typename std::iterator_traits<RandomAccessIterator>::value_type const& hi, Compare comp = Compare() );
+
+template<class ExecutionPolicy, class RandomAccessIterator, class IndexIterator, class OutputIterator, class Compare = std14::less<>>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, OutputIterator>::type
+clamp_gather( ExecutionPolicy&& policy, RandomAccessIterator first, IndexIterator index_first, IndexIterator index_last, OutputIterator out,
+    typename std::iterator_traits<RandomAccessIterator>::value_type const& lo,
+    typename std::iterator_traits<RandomAccessIterator>::value_type const& hi, Compare comp = Compare() );
+
+template<class ExecutionPolicy, class InputIterator, class IndexIterator, class RandomAccessIterator, class Compare = std14::less<>>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, void>::type
+clamp_scatter( ExecutionPolicy&& policy, InputIterator first, InputIterator last, IndexIterator index_first, RandomAccessIterator out,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp = Compare() );
+
+// type of the value that projection proj refers to in element *it, where proj
+// is a pointer to data member or a callable that returns a reference:
+
+template<class Iterator, class Projection>
+struct clamp_projected;
+
+// clamp projection proj(*it) of each element of a range in place, per
+// predicate, default std::less<>, such as one member of an array of records;
+// proj is a pointer to data member, such as &order::price, or a callable that
+// returns a reference:
+
+template<class ForwardIterator, class Projection, class Compare = std14::less<>>
+ForwardIterator clamp_range_projected( ForwardIterator first, ForwardIterator last,
+    typename clamp_projected<ForwardIterator, Projection>::type const& lo,
+    typename clamp_projected<ForwardIterator, Projection>::type const& hi, Projection proj, Compare comp = Compare() );
+
+// clamp projection per execution policy; the parallel policies split
+// random-access ranges across the thread pool of the parallel clamp_range():
+
+template<class ExecutionPolicy, class ForwardIterator, class Projection, class Compare = std14::less<>>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, ForwardIterator>::type
+clamp_range_projected( ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last,
+    typename clamp_projected<ForwardIterator, Projection>::type const& lo,
+    typename clamp_projected<ForwardIterator, Projection>::type const& hi, Projection proj, Compare comp = Compare() );
+
+// axis-aligned box [lo, hi] in N dimensions for clamp_points():
+
+template<class T, std::size_t N>
+struct clamp_box
+{
+    typedef T value_type;
+
+    std::array<T, N> lo;
+    std::array<T, N> hi;
+};
+
+// clamp points into box per predicate, default std::less<>, with the points
+// stored as records of N values of T, such as struct { float x, y, z; } or
+// std::array<float, 3> (AoS):
+
+template<class InputIterator, class OutputIterator, class T, std::size_t N, class Compare = std14::less<>>
+OutputIterator clamp_points( InputIterator first, InputIterator last, OutputIterator out,
+    clamp_box<T, N> const& box, Compare comp = Compare() );
+
+// clamp n points into box in place, with the points stored as N arrays of
+// coordinates, such as separate x, y and z arrays (SoA):
+
+template<class T, std::size_t N, class Compare = std14::less<>>
+void clamp_points( std::array<T *, N> const& axes, std::size_t n,
+    clamp_box<T, N> const& box, Compare comp = Compare() );
+
+// clamp points per execution policy; the parallel policies split the points
+// across the thread pool of the parallel clamp_range():
+
+template<class ExecutionPolicy, class InputIterator, class OutputIterator, class T, std::size_t N, class Compare = std14::less<>>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, OutputIterator>::type
+clamp_points( ExecutionPolicy&& policy, InputIterator first, InputIterator last, OutputIterator out,
+    clamp_box<T, N> const& box, Compare comp = Compare() );
+
+template<class ExecutionPolicy, class T, std::size_t N, class Compare = std14::less<>>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, void>::type
+clamp_points( ExecutionPolicy&& policy, std::array<T *, N> const& axes, std::size_t n,
+    clamp_box<T, N> const& box, Compare comp = Compare() );
+
+// 16-bit floating point storage types: IEEE 754 binary16 (fp16) and bfloat16.
+// They convert to and from float, rounding to nearest even, and compare like
+// float; clamp_range() and the other range algorithms clamp them with SIMD
+// kernels, without widening the data in memory:
+
+struct clamp_half
+{
+    std::uint16_t bits;
+
+    clamp_half() = default;
+    explicit clamp_half( float value );
+    operator float() const;
+
+    static clamp_half from_bits( std::uint16_t bits );
+};
+
+struct clamp_bfloat16
+{
+    std::uint16_t bits;
+
+    clamp_bfloat16() = default;
+    explicit clamp_bfloat16( float value );
+    operator float() const;
+
+    static clamp_bfloat16 from_bits( std::uint16_t bits );
+};
+
+template<> struct clamp_sum_type<clamp_half    > { typedef double type; };
+template<> struct clamp_sum_type<clamp_bfloat16> { typedef double type; };
+
 // ---------------------------------------------------------------------------
 // Possible implementation:
 
@@ -42,18 +651,4021 @@ constexpr const T& clamp( const T& val, const T& lo, const T& hi, Compare comp )
         comp(val, lo) ? lo : comp(hi, val) ? hi : val;
 }
 
-// clamp range of values per predicate:
+// Implementation details of clamp_value():
 
-template<class InputIterator, class OutputIterator, class Compare>
-OutputIterator clamp_range(
-    InputIterator first, InputIterator last, OutputIterator out,
-    typename std::iterator_traits<InputIterator>::value_type const& lo,
-    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp )
+namespace clamp_detail {
+
+// With arithmetic values instead of references, comp(v,lo) ? lo : v is a max
+// and comp(hi,t) ? hi : t is a min operation. The result equals clamp()'s,
+// including a NaN value with std::less<> that compares false both ways.
+
+template<class T, class Compare>
+constexpr T clamp_hi( T t, T hi, Compare comp )
+{
+    return comp(hi, t) ? hi : t;
+}
+
+template<class T, class Compare>
+constexpr T clamp_fast( T val, T lo, T hi, Compare comp, std::true_type /*arithmetic*/ )
+{
+    return assert( !comp(hi, lo) ),
+        clamp_hi( comp(val, lo) ? lo : val, hi, comp );
+}
+
+template<class T, class Compare>
+constexpr const T& clamp_fast( const T& val, const T& lo, const T& hi, Compare comp, std::false_type )
+{
+    return ::clamp( val, lo, hi, comp );
+}
+
+} // namespace clamp_detail
+
+template<class T, class Compare>
+constexpr T clamp_value( const T& val, const T& lo, const T& hi, Compare comp )
+{
+    return clamp_detail::clamp_fast( val, lo, hi, comp, std::is_arithmetic<T>() );
+}
+
+// Implementation details of clamp_half and clamp_bfloat16:
+
+namespace clamp_detail {
+
+inline std::uint32_t bits_of( float value )
+{
+    std::uint32_t bits;
+    std::memcpy( &bits, &value, sizeof bits );
+    return bits;
+}
+
+inline float float_of( std::uint32_t bits )
+{
+    float value;
+    std::memcpy( &value, &bits, sizeof value );
+    return value;
+}
+
+// binary16 conversions per F16C or in software, rounding to nearest even:
+
+inline std::uint16_t float_to_half( float value )
+{
+#if CLAMP_HAVE_F16C
+    return static_cast<std::uint16_t>( _cvtss_sh( value, _MM_FROUND_TO_NEAREST_INT ) );
+#else
+    std::uint32_t f = bits_of( value );
+    std::uint32_t const sign = f & 0x80000000u;
+    f ^= sign;
+
+    std::uint32_t h;
+
+    if ( f >= 0x47800000u )         // overflow to infinity, infinity or NaN:
+        h = f > 0x7f800000u ? 0x7e00u | ( ( f >> 13 ) & 0x3ffu ) : 0x7c00u;
+    else if ( f < 0x38800000u )     // subnormal or zero, let the FPU round:
+        h = bits_of( float_of( f ) + 0.5f ) - 0x3f000000u;
+    else                            // normal, rebias exponent and round:
+        h = ( f + 0xc8000fffu + ( ( f >> 13 ) & 1u ) ) >> 13;
+
+    return static_cast<std::uint16_t>( h | ( sign >> 16 ) );
+#endif
+}
+
+inline float half_to_float( std::uint16_t h )
+{
+#if CLAMP_HAVE_F16C
+    return _cvtsh_ss( h );
+#else
+    std::uint32_t const sign = std::uint32_t( h & 0x8000u ) << 16;
+    std::uint32_t exp  = ( h >> 10 ) & 0x1fu;
+    std::uint32_t mant = h & 0x3ffu;
+
+    if ( exp == 0x1fu )             // infinity or NaN:
+        return float_of( sign | 0x7f800000u | ( mant << 13 ) );
+
+    if ( exp == 0 )
+    {
+        if ( mant == 0 )            // zero:
+            return float_of( sign );
+
+        for ( exp = 1; !( mant & 0x400u ); --exp )  // subnormal, normalize:
+            mant <<= 1;
+        mant &= 0x3ffu;
+    }
+    return float_of( sign | ( ( exp + 112 ) << 23 ) | ( mant << 13 ) );
+#endif
+}
+
+// bfloat16 is the upper half of a float:
+
+inline std::uint16_t float_to_bfloat16( float value )
+{
+    std::uint32_t const f = bits_of( value );
+
+    return ( f & 0x7fffffffu ) > 0x7f800000u
+        ? static_cast<std::uint16_t>( ( f >> 16 ) | 0x40u )
+        : static_cast<std::uint16_t>( ( f + 0x7fffu + ( ( f >> 16 ) & 1u ) ) >> 16 );
+}
+
+inline float bfloat16_to_float( std::uint16_t b )
+{
+    return float_of( std::uint32_t( b ) << 16 );
+}
+
+} // namespace clamp_detail
+
+inline clamp_half::clamp_half( float value )
+: bits( clamp_detail::float_to_half( value ) ) {}
+
+inline clamp_half::operator float() const
+{
+    return clamp_detail::half_to_float( bits );
+}
+
+inline clamp_half clamp_half::from_bits( std::uint16_t bits )
+{
+    clamp_half h; h.bits = bits; return h;
+}
+
+inline clamp_bfloat16::clamp_bfloat16( float value )
+: bits( clamp_detail::float_to_bfloat16( value ) ) {}
+
+inline clamp_bfloat16::operator float() const
+{
+    return clamp_detail::bfloat16_to_float( bits );
+}
+
+inline clamp_bfloat16 clamp_bfloat16::from_bits( std::uint16_t bits )
+{
+    clamp_bfloat16 b; b.bits = bits; return b;
+}
+
+// Implementation details of clamp_range():
+
+namespace clamp_detail {
+
+// select T's SIMD operations by kind and size, so that e.g. char, signed char,
+// long and long long map onto the proper instructions:
+
+enum kind { signed_int, unsigned_int, floating, half_float, brain_float, other };
+
+template<class T>
+struct kind_of : std::integral_constant<int,
+    std::is_same<T, bool>::value     ? other :
+    std::is_integral<T>::value       ? ( std::is_signed<T>::value ? signed_int : unsigned_int ) :
+    std::is_floating_point<T>::value ? floating : other > {};
+
+template<> struct kind_of<clamp_half    > : std::integral_constant<int, half_float > {};
+template<> struct kind_of<clamp_bfloat16> : std::integral_constant<int, brain_float> {};
+
+inline int popcount( unsigned long long x )
+{
+#if defined( __GNUC__ )
+    return __builtin_popcountll( x );
+#else
+    int n = 0;
+    for ( ; x; x &= x - 1 )
+        ++n;
+    return n;
+#endif
+}
+
+namespace simd {
+
+// Per kind and size: reg, width, set1(), loadu(), storeu(), min(), max() and
+// count_eq(), the number of equal elements. For floating point, min(a,b) and
+// max(a,b) return b if either is NaN, so that max(lo,v) and min(hi,v)
+// propagate a NaN value like clamp() does, and if_nan(v,a,b) selects a where
+// v is NaN and b elsewhere.
+// A width of 0 means: no SIMD support for this type.
+
+template<int Kind, std::size_t Size>
+struct ops_of { enum { width = 0 }; };
+
+template<class T>
+struct ops : ops_of< kind_of<T>::value, sizeof(T) > {};
+
+template<class T>
+struct has : std::integral_constant<bool, ( ops<T>::width > 0 )> {};
+
+#if CLAMP_HAVE_SSE2
+
+struct sse2_int
+{
+    typedef __m128i reg;
+
+    static reg  loadu ( void const * p ) { return _mm_loadu_si128( static_cast<__m128i const *>( p ) ); }
+    static void storeu( void * p, reg v ) { _mm_storeu_si128( static_cast<__m128i *>( p ), v ); }
+    static void stream( void * p, reg v ) { _mm_stream_si128( static_cast<__m128i *>( p ), v ); }
+
+    // m ? a : b, per element:
+    static reg select( reg m, reg a, reg b ) { return _mm_or_si128( _mm_and_si128( m, a ), _mm_andnot_si128( m, b ) ); }
+
+    // number of set elements of given size in m:
+    static int count( reg m, int size ) { return popcount( unsigned( _mm_movemask_epi8( m ) ) ) / size; }
+};
+
+#endif // CLAMP_HAVE_SSE2
+
+#if CLAMP_HAVE_AVX2
+
+struct avx2_int
+{
+    typedef __m256i reg;
+
+    static reg  loadu ( void const * p ) { return _mm256_loadu_si256( static_cast<__m256i const *>( p ) ); }
+    static void storeu( void * p, reg v ) { _mm256_storeu_si256( static_cast<__m256i *>( p ), v ); }
+    static void stream( void * p, reg v ) { _mm256_stream_si256( static_cast<__m256i *>( p ), v ); }
+
+    // number of set elements of given size in m:
+    static int count( reg m, int size ) { return popcount( unsigned( _mm256_movemask_epi8( m ) ) ) / size; }
+};
+
+#endif // CLAMP_HAVE_AVX2
+
+#if CLAMP_HAVE_AVX512F
+
+struct avx512_int
+{
+    typedef __m512i reg;
+
+    static reg  loadu ( void const * p ) { return _mm512_loadu_si512( p ); }
+    static void storeu( void * p, reg v ) { _mm512_storeu_si512( p, v ); }
+    static void stream( void * p, reg v ) { _mm512_stream_si512( static_cast<__m512i *>( p ), v ); }
+};
+
+#endif // CLAMP_HAVE_AVX512F
+
+// 8 and 16-bit integers:
+
+#if CLAMP_HAVE_AVX512BW
+
+template<> struct ops_of<signed_int, 1> : avx512_int
+{
+    enum { width = 64 };
+    static reg set1( std::int8_t v ) { return _mm512_set1_epi8( v ); }
+    static int count_eq( reg a, reg b ) { return popcount( _mm512_cmpeq_epi8_mask( a, b ) ); }
+    static reg min( reg a, reg b ) { return _mm512_min_epi8( a, b ); }
+    static reg max( reg a, reg b ) { return _mm512_max_epi8( a, b ); }
+};
+
+template<> struct ops_of<unsigned_int, 1> : avx512_int
+{
+    enum { width = 64 };
+    static reg set1( std::uint8_t v ) { return _mm512_set1_epi8( static_cast<char>( v ) ); }
+    static int count_eq( reg a, reg b ) { return popcount( _mm512_cmpeq_epi8_mask( a, b ) ); }
+    static reg min( reg a, reg b ) { return _mm512_min_epu8( a, b ); }
+    static reg max( reg a, reg b ) { return _mm512_max_epu8( a, b ); }
+};
+
+template<> struct ops_of<signed_int, 2> : avx512_int
+{
+    enum { width = 32 };
+    static reg set1( std::int16_t v ) { return _mm512_set1_epi16( v ); }
+    static int count_eq( reg a, reg b ) { return popcount( _mm512_cmpeq_epi16_mask( a, b ) ); }
+    static reg min( reg a, reg b ) { return _mm512_min_epi16( a, b ); }
+    static reg max( reg a, reg b ) { return _mm512_max_epi16( a, b ); }
+};
+
+template<> struct ops_of<unsigned_int, 2> : avx512_int
+{
+    enum { width = 32 };
+    static reg set1( std::uint16_t v ) { return _mm512_set1_epi16( static_cast<short>( v ) ); }
+    static int count_eq( reg a, reg b ) { return popcount( _mm512_cmpeq_epi16_mask( a, b ) ); }
+    static reg min( reg a, reg b ) { return _mm512_min_epu16( a, b ); }
+    static reg max( reg a, reg b ) { return _mm512_max_epu16( a, b ); }
+};
+
+#elif CLAMP_HAVE_AVX2
+
+template<> struct ops_of<signed_int, 1> : avx2_int
+{
+    enum { width = 32 };
+    static reg set1( std::int8_t v ) { return _mm256_set1_epi8( v ); }
+    static int count_eq( reg a, reg b ) { return count( _mm256_cmpeq_epi8( a, b ), 1 ); }
+    static reg min( reg a, reg b ) { return _mm256_min_epi8( a, b ); }
+    static reg max( reg a, reg b ) { return _mm256_max_epi8( a, b ); }
+};
+
+template<> struct ops_of<unsigned_int, 1> : avx2_int
+{
+    enum { width = 32 };
+    static reg set1( std::uint8_t v ) { return _mm256_set1_epi8( static_cast<char>( v ) ); }
+    static int count_eq( reg a, reg b ) { return count( _mm256_cmpeq_epi8( a, b ), 1 ); }
+    static reg min( reg a, reg b ) { return _mm256_min_epu8( a, b ); }
+    static reg max( reg a, reg b ) { return _mm256_max_epu8( a, b ); }
+};
+
+template<> struct ops_of<signed_int, 2> : avx2_int
+{
+    enum { width = 16 };
+    static reg set1( std::int16_t v ) { return _mm256_set1_epi16( v ); }
+    static int count_eq( reg a, reg b ) { return count( _mm256_cmpeq_epi16( a, b ), 2 ); }
+    static reg min( reg a, reg b ) { return _mm256_min_epi16( a, b ); }
+    static reg max( reg a, reg b ) { return _mm256_max_epi16( a, b ); }
+};
+
+template<> struct ops_of<unsigned_int, 2> : avx2_int
+{
+    enum { width = 16 };
+    static reg set1( std::uint16_t v ) { return _mm256_set1_epi16( static_cast<short>( v ) ); }
+    static int count_eq( reg a, reg b ) { return count( _mm256_cmpeq_epi16( a, b ), 2 ); }
+    static reg min( reg a, reg b ) { return _mm256_min_epu16( a, b ); }
+    static reg max( reg a, reg b ) { return _mm256_max_epu16( a, b ); }
+};
+
+#elif CLAMP_HAVE_SSE2
+
+template<> struct ops_of<signed_int, 1> : sse2_int
+{
+    enum { width = 16 };
+    static reg set1( std::int8_t v ) { return _mm_set1_epi8( v ); }
+    static int count_eq( reg a, reg b ) { return count( _mm_cmpeq_epi8( a, b ), 1 ); }
+#if CLAMP_HAVE_SSE41
+    static reg min( reg a, reg b ) { return _mm_min_epi8( a, b ); }
+    static reg max( reg a, reg b ) { return _mm_max_epi8( a, b ); }
+#else
+    static reg min( reg a, reg b ) { return select( _mm_cmpgt_epi8( a, b ), b, a ); }
+    static reg max( reg a, reg b ) { return select( _mm_cmpgt_epi8( a, b ), a, b ); }
+#endif
+};
+
+template<> struct ops_of<unsigned_int, 1> : sse2_int
+{
+    enum { width = 16 };
+    static reg set1( std::uint8_t v ) { return _mm_set1_epi8( static_cast<char>( v ) ); }
+    static int count_eq( reg a, reg b ) { return count( _mm_cmpeq_epi8( a, b ), 1 ); }
+    static reg min( reg a, reg b ) { return _mm_min_epu8( a, b ); }
+    static reg max( reg a, reg b ) { return _mm_max_epu8( a, b ); }
+};
+
+template<> struct ops_of<signed_int, 2> : sse2_int
+{
+    enum { width = 8 };
+    static reg set1( std::int16_t v ) { return _mm_set1_epi16( v ); }
+    static int count_eq( reg a, reg b ) { return count( _mm_cmpeq_epi16( a, b ), 2 ); }
+    static reg min( reg a, reg b ) { return _mm_min_epi16( a, b ); }
+    static reg max( reg a, reg b ) { return _mm_max_epi16( a, b ); }
+};
+
+template<> struct ops_of<unsigned_int, 2> : sse2_int
+{
+    enum { width = 8 };
+    static reg set1( std::uint16_t v ) { return _mm_set1_epi16( static_cast<short>( v ) ); }
+    static int count_eq( reg a, reg b ) { return count( _mm_cmpeq_epi16( a, b ), 2 ); }
+#if CLAMP_HAVE_SSE41
+    static reg min( reg a, reg b ) { return _mm_min_epu16( a, b ); }
+    static reg max( reg a, reg b ) { return _mm_max_epu16( a, b ); }
+#else
+    // a - (a -sat b) == min(a,b), b + (a -sat b) == max(a,b):
+    static reg min( reg a, reg b ) { return _mm_sub_epi16( a, _mm_subs_epu16( a, b ) ); }
+    static reg max( reg a, reg b ) { return _mm_add_epi16( b, _mm_subs_epu16( a, b ) ); }
+#endif
+};
+
+#endif // 8 and 16-bit integers
+
+// 32 and 64-bit integers, float and double:
+
+#if CLAMP_HAVE_AVX512F
+
+template<> struct ops_of<signed_int, 4> : avx512_int
+{
+    enum { width = 16 };
+    static reg set1( std::int32_t v ) { return _mm512_set1_epi32( v ); }
+    static int count_eq( reg a, reg b ) { return popcount( _mm512_cmpeq_epi32_mask( a, b ) ); }
+    static reg min( reg a, reg b ) { return _mm512_min_epi32( a, b ); }
+    static reg max( reg a, reg b ) { return _mm512_max_epi32( a, b ); }
+};
+
+template<> struct ops_of<unsigned_int, 4> : avx512_int
+{
+    enum { width = 16 };
+    static reg set1( std::uint32_t v ) { return _mm512_set1_epi32( static_cast<int>( v ) ); }
+    static int count_eq( reg a, reg b ) { return popcount( _mm512_cmpeq_epi32_mask( a, b ) ); }
+    static reg min( reg a, reg b ) { return _mm512_min_epu32( a, b ); }
+    static reg max( reg a, reg b ) { return _mm512_max_epu32( a, b ); }
+};
+
+template<> struct ops_of<signed_int, 8> : avx512_int
+{
+    enum { width = 8 };
+    static reg set1( std::int64_t v ) { return _mm512_set1_epi64( v ); }
+    static int count_eq( reg a, reg b ) { return popcount( _mm512_cmpeq_epi64_mask( a, b ) ); }
+    static reg min( reg a, reg b ) { return _mm512_min_epi64( a, b ); }
+    static reg max( reg a, reg b ) { return _mm512_max_epi64( a, b ); }
+};
+
+template<> struct ops_of<unsigned_int, 8> : avx512_int
+{
+    enum { width = 8 };
+    static reg set1( std::uint64_t v ) { return _mm512_set1_epi64( static_cast<long long>( v ) ); }
+    static int count_eq( reg a, reg b ) { return popcount( _mm512_cmpeq_epi64_mask( a, b ) ); }
+    static reg min( reg a, reg b ) { return _mm512_min_epu64( a, b ); }
+    static reg max( reg a, reg b ) { return _mm512_max_epu64( a, b ); }
+};
+
+template<> struct ops_of<floating, 4>
+{
+    typedef __m512 reg;
+    enum { width = 16 };
+    static reg  set1  ( float v ) { return _mm512_set1_ps( v ); }
+    static int  count_eq( reg a, reg b ) { return popcount( _mm512_cmp_ps_mask( a, b, _CMP_EQ_OQ ) ); }
+    static reg  loadu ( void const * p ) { return _mm512_loadu_ps( p ); }
+    static void storeu( void * p, reg v ) { _mm512_storeu_ps( p, v ); }
+    static void stream( void * p, reg v ) { _mm512_stream_ps( static_cast<float *>( p ), v ); }
+    static reg  min( reg a, reg b ) { return _mm512_min_ps( a, b ); }
+    static reg  max( reg a, reg b ) { return _mm512_max_ps( a, b ); }
+    static reg  if_nan( reg v, reg a, reg b ) { return _mm512_mask_blend_ps( _mm512_cmp_ps_mask( v, v, _CMP_UNORD_Q ), b, a ); }
+};
+
+template<> struct ops_of<floating, 8>
+{
+    typedef __m512d reg;
+    enum { width = 8 };
+    static reg  set1  ( double v ) { return _mm512_set1_pd( v ); }
+    static int  count_eq( reg a, reg b ) { return popcount( _mm512_cmp_pd_mask( a, b, _CMP_EQ_OQ ) ); }
+    static reg  loadu ( void const * p ) { return _mm512_loadu_pd( p ); }
+    static void storeu( void * p, reg v ) { _mm512_storeu_pd( p, v ); }
+    static void stream( void * p, reg v ) { _mm512_stream_pd( static_cast<double *>( p ), v ); }
+    static reg  min( reg a, reg b ) { return _mm512_min_pd( a, b ); }
+    static reg  max( reg a, reg b ) { return _mm512_max_pd( a, b ); }
+    static reg  if_nan( reg v, reg a, reg b ) { return _mm512_mask_blend_pd( _mm512_cmp_pd_mask( v, v, _CMP_UNORD_Q ), b, a ); }
+};
+
+#elif CLAMP_HAVE_AVX2
+
+template<> struct ops_of<signed_int, 4> : avx2_int
+{
+    enum { width = 8 };
+    static reg set1( std::int32_t v ) { return _mm256_set1_epi32( v ); }
+    static int count_eq( reg a, reg b ) { return count( _mm256_cmpeq_epi32( a, b ), 4 ); }
+    static reg min( reg a, reg b ) { return _mm256_min_epi32( a, b ); }
+    static reg max( reg a, reg b ) { return _mm256_max_epi32( a, b ); }
+};
+
+template<> struct ops_of<unsigned_int, 4> : avx2_int
+{
+    enum { width = 8 };
+    static reg set1( std::uint32_t v ) { return _mm256_set1_epi32( static_cast<int>( v ) ); }
+    static int count_eq( reg a, reg b ) { return count( _mm256_cmpeq_epi32( a, b ), 4 ); }
+    static reg min( reg a, reg b ) { return _mm256_min_epu32( a, b ); }
+    static reg max( reg a, reg b ) { return _mm256_max_epu32( a, b ); }
+};
+
+template<> struct ops_of<signed_int, 8> : avx2_int
+{
+    enum { width = 4 };
+    static reg set1( std::int64_t v ) { return _mm256_set1_epi64x( v ); }
+    static int count_eq( reg a, reg b ) { return count( _mm256_cmpeq_epi64( a, b ), 8 ); }
+    static reg min( reg a, reg b ) { return _mm256_blendv_epi8( a, b, _mm256_cmpgt_epi64( a, b ) ); }
+    static reg max( reg a, reg b ) { return _mm256_blendv_epi8( b, a, _mm256_cmpgt_epi64( a, b ) ); }
+};
+
+template<> struct ops_of<unsigned_int, 8> : avx2_int
+{
+    enum { width = 4 };
+    static reg set1( std::uint64_t v ) { return _mm256_set1_epi64x( static_cast<long long>( v ) ); }
+    static int count_eq( reg a, reg b ) { return count( _mm256_cmpeq_epi64( a, b ), 8 ); }
+    static reg min( reg a, reg b ) { return _mm256_blendv_epi8( a, b, gt( a, b ) ); }
+    static reg max( reg a, reg b ) { return _mm256_blendv_epi8( b, a, gt( a, b ) ); }
+
+    // unsigned compare via signed compare of sign-flipped values:
+    static reg gt( reg a, reg b )
+    {
+        reg const bias = _mm256_set1_epi64x( static_cast<long long>( 0x8000000000000000ULL ) );
+        return _mm256_cmpgt_epi64( _mm256_xor_si256( a, bias ), _mm256_xor_si256( b, bias ) );
+    }
+};
+
+template<> struct ops_of<floating, 4>
+{
+    typedef __m256 reg;
+    enum { width = 8 };
+    static reg  set1  ( float v ) { return _mm256_set1_ps( v ); }
+    static int  count_eq( reg a, reg b ) { return popcount( unsigned( _mm256_movemask_ps( _mm256_cmp_ps( a, b, _CMP_EQ_OQ ) ) ) ); }
+    static reg  loadu ( void const * p ) { return _mm256_loadu_ps( static_cast<float const *>( p ) ); }
+    static void storeu( void * p, reg v ) { _mm256_storeu_ps( static_cast<float *>( p ), v ); }
+    static void stream( void * p, reg v ) { _mm256_stream_ps( static_cast<float *>( p ), v ); }
+    static reg  min( reg a, reg b ) { return _mm256_min_ps( a, b ); }
+    static reg  max( reg a, reg b ) { return _mm256_max_ps( a, b ); }
+    static reg  if_nan( reg v, reg a, reg b ) { return _mm256_blendv_ps( b, a, _mm256_cmp_ps( v, v, _CMP_UNORD_Q ) ); }
+};
+
+template<> struct ops_of<floating, 8>
+{
+    typedef __m256d reg;
+    enum { width = 4 };
+    static reg  set1  ( double v ) { return _mm256_set1_pd( v ); }
+    static int  count_eq( reg a, reg b ) { return popcount( unsigned( _mm256_movemask_pd( _mm256_cmp_pd( a, b, _CMP_EQ_OQ ) ) ) ); }
+    static reg  loadu ( void const * p ) { return _mm256_loadu_pd( static_cast<double const *>( p ) ); }
+    static void storeu( void * p, reg v ) { _mm256_storeu_pd( static_cast<double *>( p ), v ); }
+    static void stream( void * p, reg v ) { _mm256_stream_pd( static_cast<double *>( p ), v ); }
+    static reg  min( reg a, reg b ) { return _mm256_min_pd( a, b ); }
+    static reg  max( reg a, reg b ) { return _mm256_max_pd( a, b ); }
+    static reg  if_nan( reg v, reg a, reg b ) { return _mm256_blendv_pd( b, a, _mm256_cmp_pd( v, v, _CMP_UNORD_Q ) ); }
+};
+
+#elif CLAMP_HAVE_SSE2
+
+template<> struct ops_of<signed_int, 4> : sse2_int
+{
+    enum { width = 4 };
+    static reg set1( std::int32_t v ) { return _mm_set1_epi32( v ); }
+    static int count_eq( reg a, reg b ) { return count( _mm_cmpeq_epi32( a, b ), 4 ); }
+#if CLAMP_HAVE_SSE41
+    static reg min( reg a, reg b ) { return _mm_min_epi32( a, b ); }
+    static reg max( reg a, reg b ) { return _mm_max_epi32( a, b ); }
+#else
+    static reg min( reg a, reg b ) { return select( _mm_cmpgt_epi32( a, b ), b, a ); }
+    static reg max( reg a, reg b ) { return select( _mm_cmpgt_epi32( a, b ), a, b ); }
+#endif
+};
+
+template<> struct ops_of<unsigned_int, 4> : sse2_int
+{
+    enum { width = 4 };
+    static reg set1( std::uint32_t v ) { return _mm_set1_epi32( static_cast<int>( v ) ); }
+    static int count_eq( reg a, reg b ) { return count( _mm_cmpeq_epi32( a, b ), 4 ); }
+#if CLAMP_HAVE_SSE41
+    static reg min( reg a, reg b ) { return _mm_min_epu32( a, b ); }
+    static reg max( reg a, reg b ) { return _mm_max_epu32( a, b ); }
+#else
+    static reg min( reg a, reg b ) { return select( gt( a, b ), b, a ); }
+    static reg max( reg a, reg b ) { return select( gt( a, b ), a, b ); }
+
+    // unsigned compare via signed compare of sign-flipped values:
+    static reg gt( reg a, reg b )
+    {
+        reg const bias = _mm_set1_epi32( static_cast<int>( 0x80000000U ) );
+        return _mm_cmpgt_epi32( _mm_xor_si128( a, bias ), _mm_xor_si128( b, bias ) );
+    }
+#endif
+};
+
+template<> struct ops_of<floating, 4>
+{
+    typedef __m128 reg;
+    enum { width = 4 };
+    static reg  set1  ( float v ) { return _mm_set1_ps( v ); }
+    static int  count_eq( reg a, reg b ) { return popcount( unsigned( _mm_movemask_ps( _mm_cmpeq_ps( a, b ) ) ) ); }
+    static reg  loadu ( void const * p ) { return _mm_loadu_ps( static_cast<float const *>( p ) ); }
+    static void storeu( void * p, reg v ) { _mm_storeu_ps( static_cast<float *>( p ), v ); }
+    static void stream( void * p, reg v ) { _mm_stream_ps( static_cast<float *>( p ), v ); }
+    static reg  min( reg a, reg b ) { return _mm_min_ps( a, b ); }
+    static reg  max( reg a, reg b ) { return _mm_max_ps( a, b ); }
+    static reg  if_nan( reg v, reg a, reg b ) { reg const m = _mm_cmpunord_ps( v, v ); return _mm_or_ps( _mm_and_ps( m, a ), _mm_andnot_ps( m, b ) ); }
+};
+
+template<> struct ops_of<floating, 8>
+{
+    typedef __m128d reg;
+    enum { width = 2 };
+    static reg  set1  ( double v ) { return _mm_set1_pd( v ); }
+    static int  count_eq( reg a, reg b ) { return popcount( unsigned( _mm_movemask_pd( _mm_cmpeq_pd( a, b ) ) ) ); }
+    static reg  loadu ( void const * p ) { return _mm_loadu_pd( static_cast<double const *>( p ) ); }
+    static void storeu( void * p, reg v ) { _mm_storeu_pd( static_cast<double *>( p ), v ); }
+    static void stream( void * p, reg v ) { _mm_stream_pd( static_cast<double *>( p ), v ); }
+    static reg  min( reg a, reg b ) { return _mm_min_pd( a, b ); }
+    static reg  max( reg a, reg b ) { return _mm_max_pd( a, b ); }
+    static reg  if_nan( reg v, reg a, reg b ) { reg const m = _mm_cmpunord_pd( v, v ); return _mm_or_pd( _mm_and_pd( m, a ), _mm_andnot_pd( m, b ) ); }
+};
+
+#endif // 32 and 64-bit integers, float and double
+
+// 16-bit floating point values are sign-magnitude integers. Clamp them as
+// integers, with keys that order like the values: the magnitude, negated for
+// negative values, which makes the keys of +0 and -0 equal. NaN values, with
+// a magnitude above that of infinity, never compare less. min() and max()
+// select one of the original values, so a zero keeps its sign like clamp():
+
+#if CLAMP_HAVE_AVX2
+
+template<class T, int Inf>
+struct float16_ops : avx2_int
+{
+    enum { width = 16 };
+    static reg set1( T v ) { return _mm256_set1_epi16( static_cast<short>( v.bits ) ); }
+    static int count_eq( reg a, reg b ) { return count( _mm256_andnot_si256( nan( a, b ), _mm256_cmpeq_epi16( key( a ), key( b ) ) ), 2 ); }
+    static reg min( reg a, reg b ) { return _mm256_blendv_epi8( b, a, lt( a, b ) ); }
+    static reg max( reg a, reg b ) { return _mm256_blendv_epi8( b, a, lt( b, a ) ); }
+    static reg if_nan( reg v, reg a, reg b ) { return _mm256_blendv_epi8( b, a, nan( v, v ) ); }
+
+    static reg magnitude( reg a ) { return _mm256_and_si256( a, _mm256_set1_epi16( 0x7fff ) ); }
+    static reg key( reg a ) { reg const s = _mm256_srai_epi16( a, 15 ); return _mm256_sub_epi16( _mm256_xor_si256( magnitude( a ), s ), s ); }
+    static reg nan( reg a, reg b ) { reg const inf = _mm256_set1_epi16( Inf ); return _mm256_or_si256( _mm256_cmpgt_epi16( magnitude( a ), inf ), _mm256_cmpgt_epi16( magnitude( b ), inf ) ); }
+    static reg lt( reg a, reg b ) { return _mm256_andnot_si256( nan( a, b ), _mm256_cmpgt_epi16( key( b ), key( a ) ) ); }
+};
+
+#elif CLAMP_HAVE_SSE2
+
+template<class T, int Inf>
+struct float16_ops : sse2_int
+{
+    enum { width = 8 };
+    static reg set1( T v ) { return _mm_set1_epi16( static_cast<short>( v.bits ) ); }
+    static int count_eq( reg a, reg b ) { return count( _mm_andnot_si128( nan( a, b ), _mm_cmpeq_epi16( key( a ), key( b ) ) ), 2 ); }
+    static reg min( reg a, reg b ) { return select( lt( a, b ), a, b ); }
+    static reg max( reg a, reg b ) { return select( lt( b, a ), a, b ); }
+    static reg if_nan( reg v, reg a, reg b ) { return select( nan( v, v ), a, b ); }
+
+    static reg magnitude( reg a ) { return _mm_and_si128( a, _mm_set1_epi16( 0x7fff ) ); }
+    static reg key( reg a ) { reg const s = _mm_srai_epi16( a, 15 ); return _mm_sub_epi16( _mm_xor_si128( magnitude( a ), s ), s ); }
+    static reg nan( reg a, reg b ) { reg const inf = _mm_set1_epi16( Inf ); return _mm_or_si128( _mm_cmpgt_epi16( magnitude( a ), inf ), _mm_cmpgt_epi16( magnitude( b ), inf ) ); }
+    static reg lt( reg a, reg b ) { return _mm_andnot_si128( nan( a, b ), _mm_cmpgt_epi16( key( b ), key( a ) ) ); }
+};
+
+#endif
+
+#if CLAMP_HAVE_F16C
+
+// with F16C, clamp binary16 values as float, converting to and from 16 bits
+// in registers:
+
+template<> struct ops_of<half_float, 2>
+{
+    typedef __m256 reg;
+    enum { width = 8 };
+    static reg  set1  ( clamp_half v ) { return _mm256_set1_ps( float( v ) ); }
+    static int  count_eq( reg a, reg b ) { return popcount( unsigned( _mm256_movemask_ps( _mm256_cmp_ps( a, b, _CMP_EQ_OQ ) ) ) ); }
+    static reg  loadu ( void const * p ) { return _mm256_cvtph_ps( _mm_loadu_si128( static_cast<__m128i const *>( p ) ) ); }
+    static void storeu( void * p, reg v ) { _mm_storeu_si128( static_cast<__m128i *>( p ), _mm256_cvtps_ph( v, _MM_FROUND_TO_NEAREST_INT ) ); }
+    static void stream( void * p, reg v ) { _mm_stream_si128( static_cast<__m128i *>( p ), _mm256_cvtps_ph( v, _MM_FROUND_TO_NEAREST_INT ) ); }
+    static reg  min( reg a, reg b ) { return _mm256_min_ps( a, b ); }
+    static reg  max( reg a, reg b ) { return _mm256_max_ps( a, b ); }
+    static reg  if_nan( reg v, reg a, reg b ) { return _mm256_blendv_ps( b, a, _mm256_cmp_ps( v, v, _CMP_UNORD_Q ) ); }
+};
+
+#elif CLAMP_HAVE_SSE2
+
+template<> struct ops_of<half_float, 2> : float16_ops<clamp_half, 0x7c00> {};
+
+#endif
+
+#if CLAMP_HAVE_SSE2
+
+template<> struct ops_of<brain_float, 2> : float16_ops<clamp_bfloat16, 0x7f80> {};
+
+#endif
+
+// clamp n contiguous elements to [lo, hi] with std::less<>:
+
+template<class T>
+void clamp_n( T const * first, std::size_t n, T * out, T const lo, T const hi )
+{
+    typedef ops<T> V;
+    std::size_t const w = V::width;
+
+    if ( n < w )
+    {
+        for ( std::size_t i = 0; i < n; ++i )
+            out[i] = clamp_value( first[i], lo, hi );
+        return;
+    }
+
+    auto const vlo = V::set1( lo );
+    auto const vhi = V::set1( hi );
+
+    std::size_t i = 0;
+    for ( ; i + w <= n; i += w )
+    {
+        V::storeu( out + i, V::min( vhi, V::max( vlo, V::loadu( first + i ) ) ) );
+    }
+
+    // clamp() is idempotent, so the tail may overlap already clamped elements:
+    if ( i < n )
+    {
+        i = n - w;
+        V::storeu( out + i, V::min( vhi, V::max( vlo, V::loadu( first + i ) ) ) );
+    }
+}
+
+// clamp n contiguous elements to [lo, hi] with std::less<>, with non-temporal
+// stores of whole cache lines, which skip reading the output lines into the
+// cache, and prefetching the input ahead; head and tail use clamp_n():
+
+#if CLAMP_HAVE_SSE2
+
+template<class T>
+void clamp_n_streaming( T const * first, std::size_t n, T * out, T const lo, T const hi )
+{
+    typedef ops<T> V;
+    std::size_t const w = V::width;
+    std::size_t const line = 64 / sizeof(T);
+    std::size_t const ahead = 16 * 64;
+
+    std::size_t const head = ( 64 - reinterpret_cast<std::uintptr_t>( out ) % 64 ) % 64 / sizeof(T);
+
+    if ( n < head + line )
+        return clamp_n<T>( first, n, out, lo, hi );
+
+    clamp_n<T>( first, head, out, lo, hi );
+
+    auto const vlo = V::set1( lo );
+    auto const vhi = V::set1( hi );
+
+    std::size_t i = head;
+    for ( ; i + line <= n; i += line )
+    {
+        _mm_prefetch( reinterpret_cast<char const *>( first + i ) + ahead, _MM_HINT_T0 );
+
+        for ( std::size_t k = i; k != i + line; k += w )
+            V::stream( out + k, V::min( vhi, V::max( vlo, V::loadu( first + k ) ) ) );
+    }
+    _mm_sfence();
+
+    clamp_n<T>( first + i, n - i, out + i, lo, hi );
+}
+
+#else
+
+template<class T>
+void clamp_n_streaming( T const * first, std::size_t n, T * out, T const lo, T const hi )
+{
+    clamp_n<T>( first, n, out, lo, hi );
+}
+
+#endif // CLAMP_HAVE_SSE2
+
+// clamp n contiguous elements to [lo, hi] with std::less<> in place, storing
+// only the vectors with a value that changes; a NaN value counts as changed:
+
+template<class T>
+void clamp_n_changed( T * first, std::size_t n, T const lo, T const hi )
+{
+    typedef ops<T> V;
+    std::size_t const w = V::width;
+
+    if ( n < w )
+    {
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            if      ( first[i] < lo ) first[i] = lo;
+            else if ( hi < first[i] ) first[i] = hi;
+        }
+        return;
+    }
+
+    auto const vlo = V::set1( lo );
+    auto const vhi = V::set1( hi );
+
+    auto const clamp_at = [&]( std::size_t i )
+    {
+        auto const v = V::loadu( first + i );
+        auto const c = V::min( vhi, V::max( vlo, v ) );
+
+        if ( V::count_eq( c, v ) != int( w ) )
+            V::storeu( first + i, c );
+    };
+
+    std::size_t i = 0;
+    for ( ; i + w <= n; i += w )
+        clamp_at( i );
+
+    if ( i < n )
+        clamp_at( n - w );
+}
+
+} // namespace simd
+
+// contiguous iterators over T: pointers and std::vector<T> iterators:
+
+template<class It, class T>
+struct is_contiguous_input : std::integral_constant<bool,
+    std::is_same<It, T *>::value || std::is_same<It, T const *>::value ||
+    std::is_same<It, typename std::vector<T>::iterator>::value ||
+    std::is_same<It, typename std::vector<T>::const_iterator>::value > {};
+
+template<class It, class T>
+struct is_contiguous_output : std::integral_constant<bool,
+    std::is_same<It, T *>::value ||
+    std::is_same<It, typename std::vector<T>::iterator>::value > {};
+
+// comparators that the SIMD kernels implement:
+
+template<class Compare, class T> struct is_less    : std::false_type {};
+template<class Compare, class T> struct is_greater : std::false_type {};
+
+template<class T> struct is_less   < std14::less<>   , T > : std::true_type {};
+template<class T> struct is_less   < std14::less<T>  , T > : std::true_type {};
+template<class T> struct is_greater< std14::greater<>, T > : std::true_type {};
+template<class T> struct is_greater< std14::greater<T>,T > : std::true_type {};
+
+#if __cplusplus == 201103L
+template<class T> struct is_less   < std::less<T>   , T > : std::true_type {};
+template<class T> struct is_greater< std::greater<T>, T > : std::true_type {};
+#endif
+
+// use a SIMD kernel for contiguous arithmetic data compared with less or greater:
+
+template<bool B, class Then> struct lazy_and : std::false_type {};
+template<class Then> struct lazy_and<true, Then> : Then {};
+
+template<class InputIterator, class OutputIterator, class Compare,
+         class T = typename std::iterator_traits<InputIterator>::value_type>
+struct use_simd : lazy_and< simd::has<T>::value, std::integral_constant<bool,
+    is_contiguous_input<InputIterator, T>::value &&
+    is_contiguous_output<OutputIterator, T>::value &&
+    ( is_less<Compare, T>::value || is_greater<Compare, T>::value ) > > {};
+
+// iterator that dereferences to an lvalue, whose address can be taken; a
+// proxy iterator's reference is a value:
+
+template<class Iterator>
+struct is_lvalue_iterator : std::is_lvalue_reference<typename std::iterator_traits<Iterator>::reference> {};
+
+// output that may refer to the input: iterators of the same type, or
+// contiguous iterators over the same type, that dereference to lvalues:
+
+template<class InputIterator, class OutputIterator,
+         class T = typename std::iterator_traits<InputIterator>::value_type>
+struct may_alias : std::integral_constant<bool,
+    ( std::is_same<InputIterator, OutputIterator>::value ||
+      ( is_contiguous_input<InputIterator, T>::value && is_contiguous_output<OutputIterator, T>::value ) ) &&
+    is_lvalue_iterator<InputIterator>::value && is_lvalue_iterator<OutputIterator>::value > {};
+
+template<class InputIterator, class OutputIterator>
+bool in_place( InputIterator first, InputIterator last, OutputIterator out, std::true_type )
+{
+    return first != last && std::addressof( *first ) == std::addressof( *out );
+}
+
+template<class InputIterator, class OutputIterator>
+bool in_place( InputIterator, InputIterator, OutputIterator, std::false_type )
+{
+    return false;
+}
+
+// whether out refers to the input, also through move iterators:
+
+template<class InputIterator, class OutputIterator>
+bool in_place( InputIterator first, InputIterator last, OutputIterator out )
+{
+    return in_place( first, last, out, may_alias<InputIterator, OutputIterator>() );
+}
+
+template<class Iterator, class OutputIterator>
+bool in_place( std::move_iterator<Iterator> first, std::move_iterator<Iterator> last, OutputIterator out )
+{
+    return in_place( first.base(), last.base(), out );
+}
+
+// generic clamp_range() for arithmetic types:
+
+template<class InputIterator, class OutputIterator, class T, class Compare>
+OutputIterator clamp_assign( InputIterator first, InputIterator last, OutputIterator out,
+    T const& lo, T const& hi, Compare comp, std::true_type /*arithmetic*/ )
+{
+    return std::transform( first, last, out, [&](T const& val) { return clamp_fast(val, lo, hi, comp, std::true_type()); } );
+}
+
+// generic clamp_range() for other types: assign lo, hi or the value itself,
+// which is moved from move iterators; in place, values in range are not
+// assigned at all:
+
+template<class InputIterator, class OutputIterator, class T, class Compare>
+OutputIterator clamp_assign( InputIterator first, InputIterator last, OutputIterator out,
+    T const& lo, T const& hi, Compare comp, std::false_type /*arithmetic*/ )
+{
+    assert( !comp(hi, lo) );
+
+    bool const skip = in_place( first, last, out );
+
+    for ( ; first != last; ++first, ++out )
+    {
+        auto && val = *first;
+
+        if      ( comp( val, lo ) ) *out = lo;
+        else if ( comp( hi, val ) ) *out = hi;
+        else if ( !skip           ) *out = std::forward<decltype(val)>( val );
+    }
+    return out;
+}
+
+// generic clamp_range():
+
+template<class InputIterator, class OutputIterator, class T, class Compare, class StorePolicy = clamp_store::automatic_policy>
+OutputIterator clamp_range(
+    InputIterator first, InputIterator last, OutputIterator out,
+    T const& lo, T const& hi, Compare comp, std::false_type, StorePolicy = StorePolicy() )
+{
+    return clamp_assign( first, last, out, lo, hi, comp, std::is_arithmetic<T>() );
+}
+
+// select non-temporal stores per store policy and size of output:
+
+inline bool use_streaming( clamp_store::automatic_policy, void const * src, void const * dst, std::size_t bytes )
+{
+    return CLAMP_STREAMING_THRESHOLD > 0 && bytes >= std::size_t( CLAMP_STREAMING_THRESHOLD ) && src != dst;
+}
+
+inline bool use_streaming( clamp_store::cached_policy, void const *, void const *, std::size_t )
+{
+    return false;
+}
+
+inline bool use_streaming( clamp_store::streaming_policy, void const *, void const *, std::size_t )
+{
+    return true;
+}
+
+// SIMD clamp_range(), clamping to [hi, lo] for greater is equivalent:
+
+template<class InputIterator, class OutputIterator, class T, class Compare, class StorePolicy = clamp_store::automatic_policy>
+OutputIterator clamp_range(
+    InputIterator first, InputIterator last, OutputIterator out,
+    T const& lo, T const& hi, Compare comp, std::true_type, StorePolicy store = StorePolicy() )
+{
+    assert( !comp(hi, lo) ); (void) comp;
+
+    auto const n = std::distance( first, last );
+
+    if ( n <= 0 )
+        return out;
+
+    auto const src = std::addressof( *first );
+    auto const dst = std::addressof( *out );
+
+    T const & l = is_greater<Compare, T>::value ? hi : lo;
+    T const & h = is_greater<Compare, T>::value ? lo : hi;
+
+    if ( use_streaming( store, src, dst, static_cast<std::size_t>( n ) * sizeof(T) ) )
+        simd::clamp_n_streaming<T>( src, static_cast<std::size_t>( n ), dst, l, h );
+    else
+        simd::clamp_n<T>( src, static_cast<std::size_t>( n ), dst, l, h );
+
+    return out + n;
+}
+
+// clamp_range() per clamp_store::changed: in place, store only the values
+// that change, otherwise clamp like clamp_range():
+
+template<class InputIterator, class OutputIterator, class T, class Compare>
+OutputIterator clamp_range(
+    InputIterator first, InputIterator last, OutputIterator out,
+    T const& lo, T const& hi, Compare comp, std::false_type, clamp_store::changed_policy )
+{
+    if ( !in_place( first, last, out ) )
+        return clamp_range( first, last, out, lo, hi, comp, std::false_type() );
+
+    assert( !comp(hi, lo) );
+
+    for ( ; first != last; ++first, ++out )
+    {
+        if      ( comp( *first, lo ) ) *out = lo;
+        else if ( comp( hi, *first ) ) *out = hi;
+    }
+    return out;
+}
+
+template<class InputIterator, class OutputIterator, class T, class Compare>
+OutputIterator clamp_range(
+    InputIterator first, InputIterator last, OutputIterator out,
+    T const& lo, T const& hi, Compare comp, std::true_type, clamp_store::changed_policy )
+{
+    if ( !in_place( first, last, out, std::true_type() ) )
+        return clamp_range( first, last, out, lo, hi, comp, std::true_type(), clamp_store::cached );
+
+    assert( !comp(hi, lo) ); (void) comp;
+
+    auto const n = std::distance( first, last );
+
+    if ( is_greater<Compare, T>::value )
+        simd::clamp_n_changed<T>( std::addressof( *out ), static_cast<std::size_t>( n ), hi, lo );
+    else
+        simd::clamp_n_changed<T>( std::addressof( *out ), static_cast<std::size_t>( n ), lo, hi );
+
+    return out + n;
+}
+
+} // namespace clamp_detail
+
+// clamp range of values per predicate:
+
+template<class InputIterator, class OutputIterator, class Compare>
+OutputIterator clamp_range(
+    InputIterator first, InputIterator last, OutputIterator out,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp )
+{
+    return clamp_detail::clamp_range( first, last, out, lo, hi, comp,
+        clamp_detail::use_simd<InputIterator, OutputIterator, Compare>() );
+}
+
+// Implementation details of the parallel clamp_range():
+
+namespace clamp_detail {
+
+// reusable pool of worker threads, created on first use:
+
+class thread_pool
+{
+public:
+    static thread_pool & instance()
+    {
+        static thread_pool pool( CLAMP_THREAD_POOL_SIZE > 0
+            ? CLAMP_THREAD_POOL_SIZE : default_size() );
+        return pool;
+    }
+
+    static unsigned default_size()
+    {
+        unsigned const n = std::thread::hardware_concurrency();
+        return n > 1 ? n - 1 : 0;
+    }
+
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            stopping = true;
+        }
+        wakeup.notify_all();
+
+        for ( auto & t : workers )
+            t.join();
+    }
+
+    std::size_t size() const
+    {
+        return workers.size();
+    }
+
+    void submit( std::function<void()> task )
+    {
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            tasks.push_back( std::move( task ) );
+        }
+        wakeup.notify_one();
+    }
+
+private:
+    explicit thread_pool( unsigned count )
+    : workers(), tasks(), mutex(), wakeup(), stopping( false )
+    {
+        for ( unsigned i = 0; i < count; ++i )
+            workers.emplace_back( [this]{ work(); } );
+    }
+
+    thread_pool( thread_pool const & ) = delete;
+    thread_pool & operator=( thread_pool const & ) = delete;
+
+    void work()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock( mutex );
+                wakeup.wait( lock, [this]{ return stopping || !tasks.empty(); } );
+
+                if ( tasks.empty() )
+                    return;
+
+                task = std::move( tasks.front() );
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    bool stopping;
+};
+
+// call f(i) for i in [0, count) on the pool and the calling thread; the caller
+// claims chunks too, so it never waits for an idle worker (also not if nested);
+// the first exception thrown is rethrown in the calling thread:
+
+template<class F>
+void parallel_for( std::size_t count, F f )
+{
+    struct state
+    {
+        explicit state( std::size_t count ) : count( count ), next( 0 ), done( 0 ) {}
+
+        std::size_t const count;
+        std::atomic<std::size_t> next;
+        std::size_t done;
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+
+    auto const shared = std::make_shared<state>( count );
+
+    auto const run = [shared, f]()
+    {
+        for ( std::size_t i; ( i = shared->next++ ) < shared->count; )
+        {
+            std::exception_ptr error;
+            try { f( i ); } catch ( ... ) { error = std::current_exception(); }
+
+            std::lock_guard<std::mutex> lock( shared->mutex );
+            if ( error && !shared->error )
+                shared->error = error;
+            if ( ++shared->done == shared->count )
+                shared->finished.notify_all();
+        }
+    };
+
+    thread_pool & pool = thread_pool::instance();
+
+    for ( std::size_t k = 1; k < count && k <= pool.size(); ++k )
+        pool.submit( run );
+
+    run();
+
+    std::unique_lock<std::mutex> lock( shared->mutex );
+    shared->finished.wait( lock, [&]{ return shared->done == shared->count; } );
+
+    if ( shared->error )
+        std::rethrow_exception( shared->error );
+}
+
+// whether the chunks of a parallel clamp_range() use non-temporal stores: per
+// the size of the whole output, not of a chunk:
+
+template<class InputIterator, class OutputIterator>
+bool parallel_streaming( InputIterator first, OutputIterator out, std::size_t n, std::true_type )
+{
+    return use_streaming( clamp_store::automatic, std::addressof( *first ), std::addressof( *out ), n * sizeof( *first ) );
+}
+
+template<class InputIterator, class OutputIterator>
+bool parallel_streaming( InputIterator, OutputIterator, std::size_t, std::false_type )
+{
+    return false;
+}
+
+// clamp random-access ranges in chunks of at least half the threshold, about
+// four chunks per thread, rounded to whole SIMD vectors:
+
+template<class InputIterator, class OutputIterator, class T, class Compare>
+OutputIterator parallel_clamp_range(
+    InputIterator first, InputIterator last, OutputIterator out,
+    T const& lo, T const& hi, Compare comp, std::true_type )
+{
+    typedef typename std::iterator_traits<InputIterator>::difference_type diff_t;
+
+    diff_t const n = std::distance( first, last );
+
+    if ( n < diff_t( CLAMP_PARALLEL_THRESHOLD ) || thread_pool::instance().size() == 0 )
+        return ::clamp_range( first, last, out, lo, hi, comp );
+
+    diff_t const min_chunk = diff_t( CLAMP_PARALLEL_THRESHOLD ) / 2;
+    diff_t const max_count = diff_t( 4 * ( thread_pool::instance().size() + 1 ) );
+    diff_t const count     = std::min( max_count, n / min_chunk );
+    diff_t const chunk     = ( ( n + count - 1 ) / count + 63 ) / 64 * 64;
+
+    bool const streaming = parallel_streaming( first, out, static_cast<std::size_t>( n ),
+        use_simd<InputIterator, OutputIterator, Compare>() );
+
+    parallel_for( static_cast<std::size_t>( ( n + chunk - 1 ) / chunk ), [=]( std::size_t i )
+    {
+        diff_t const pos = diff_t( i ) * chunk;
+        diff_t const len = std::min( chunk, n - pos );
+
+        if ( streaming )
+            ::clamp_range( clamp_store::streaming, first + pos, first + pos + len, out + pos, lo, hi, comp );
+        else
+            ::clamp_range( first + pos, first + pos + len, out + pos, lo, hi, comp );
+    });
+
+    return out + n;
+}
+
+template<class InputIterator, class OutputIterator, class T, class Compare>
+OutputIterator parallel_clamp_range(
+    InputIterator first, InputIterator last, OutputIterator out,
+    T const& lo, T const& hi, Compare comp, std::false_type )
+{
+    return ::clamp_range( first, last, out, lo, hi, comp );
+}
+
+template<class It>
+struct is_random_access : std::is_base_of< std::random_access_iterator_tag,
+    typename std::iterator_traits<It>::iterator_category > {};
+
+template<class InputIterator, class OutputIterator>
+struct use_parallel : std::integral_constant<bool,
+    is_random_access<InputIterator>::value && is_random_access<OutputIterator>::value > {};
+
+// dispatch per execution policy:
+
+template<class InputIterator, class OutputIterator, class T, class Compare>
+OutputIterator clamp_range( clamp_execution::sequenced_policy,
+    InputIterator first, InputIterator last, OutputIterator out, T const& lo, T const& hi, Compare comp )
+{
+    return ::clamp_range( first, last, out, lo, hi, comp );
+}
+
+template<class InputIterator, class OutputIterator, class T, class Compare>
+OutputIterator clamp_range( clamp_execution::parallel_policy,
+    InputIterator first, InputIterator last, OutputIterator out, T const& lo, T const& hi, Compare comp )
+{
+    return parallel_clamp_range( first, last, out, lo, hi, comp,
+        use_parallel<InputIterator, OutputIterator>() );
+}
+
+template<class InputIterator, class OutputIterator, class T, class Compare>
+OutputIterator clamp_range( clamp_execution::parallel_unsequenced_policy,
+    InputIterator first, InputIterator last, OutputIterator out, T const& lo, T const& hi, Compare comp )
+{
+    return parallel_clamp_range( first, last, out, lo, hi, comp,
+        use_parallel<InputIterator, OutputIterator>() );
+}
+
+} // namespace clamp_detail
+
+// clamp range of values per predicate and execution policy:
+
+template<class ExecutionPolicy, class InputIterator, class OutputIterator, class Compare>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, OutputIterator>::type
+clamp_range( ExecutionPolicy&& policy, InputIterator first, InputIterator last, OutputIterator out,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp )
+{
+    return clamp_detail::clamp_range(
+        typename std::decay<ExecutionPolicy>::type( policy ), first, last, out, lo, hi, comp );
+}
+
+// clamp range of values per store policy:
+
+template<class StorePolicy, class InputIterator, class OutputIterator, class Compare>
+typename clamp_store::enable_if_policy<StorePolicy, OutputIterator>::type
+clamp_range( StorePolicy policy, InputIterator first, InputIterator last, OutputIterator out,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp )
+{
+    return clamp_detail::clamp_range( first, last, out, lo, hi, comp,
+        clamp_detail::use_simd<InputIterator, OutputIterator, Compare>(), typename std::decay<StorePolicy>::type( policy ) );
+}
+
+// Implementation details of clamp_cast():
+
+namespace clamp_detail {
+
+enum conversion { exact, int_to_int, float_to_int, float_to_float };
+
+// integer to floating point and widening floating point conversions are exact
+// or round to nearest; they need no clamping:
+
+template<class To, class From>
+struct conversion_of : std::integral_constant<int,
+    std::is_floating_point<From>::value
+        ? ( std::is_floating_point<To>::value
+            ? ( sizeof(To) < sizeof(From) ? float_to_float : exact ) : float_to_int )
+        : ( std::is_floating_point<To>::value ? exact : int_to_int ) > {};
+
+template<class T>
+constexpr bool is_negative( T val, std::true_type /*signed*/ )
+{
+    return val < T(0);
+}
+
+template<class T>
+constexpr bool is_negative( T, std::false_type )
+{
+    return false;
+}
+
+template<class To, class From>
+constexpr bool below_range( From val )
+{
+    return is_negative( val, std::is_signed<From>() ) && ( std::is_unsigned<To>::value ||
+        std::intmax_t( val ) < std::intmax_t( std::numeric_limits<To>::min() ) );
+}
+
+template<class To, class From>
+constexpr bool above_range( From val )
+{
+    return !is_negative( val, std::is_signed<From>() ) &&
+        std::uintmax_t( val ) > std::uintmax_t( std::numeric_limits<To>::max() );
+}
+
+// To's maximum plus one, a power of two that From represents exactly:
+
+template<class To, class From>
+constexpr From int_end()
+{
+    return From(2) * From( std::numeric_limits<To>::max() / 2 + 1 );
+}
+
+template<class To, class From>
+constexpr To saturate( From val, std::integral_constant<int, exact> )
+{
+    return static_cast<To>( val );
+}
+
+template<class To, class From>
+constexpr To saturate( From val, std::integral_constant<int, int_to_int> )
+{
+    return below_range<To>( val ) ? std::numeric_limits<To>::min()
+         : above_range<To>( val ) ? std::numeric_limits<To>::max() : static_cast<To>( val );
+}
+
+template<class To, class From>
+constexpr To saturate( From val, std::integral_constant<int, float_to_int> )
+{
+    return val != val                                  ? To(0)
+         : val <  From( std::numeric_limits<To>::min() ) ? std::numeric_limits<To>::min()
+         : val >= int_end<To, From>()                      ? std::numeric_limits<To>::max() : static_cast<To>( val );
+}
+
+// finite values beyond To's range saturate, infinities and NaN convert as is:
+
+template<class To, class From>
+constexpr To saturate( From val, std::integral_constant<int, float_to_float> )
+{
+    return val == std::numeric_limits<From>::infinity() || val == -std::numeric_limits<From>::infinity()
+        ? static_cast<To>( val )
+        : static_cast<To>( clamp_value( val,
+            From( std::numeric_limits<To>::lowest() ), From( std::numeric_limits<To>::max() ) ) );
+}
+
+} // namespace clamp_detail
+
+template<class To, class From>
+constexpr To clamp_cast( From const& val )
+{
+    static_assert( std::is_arithmetic<From>::value && std::is_arithmetic<To>::value && !std::is_same<To, bool>::value,
+        "clamp_cast: expect arithmetic types, not converting to bool" );
+
+    return clamp_detail::saturate<To>( val,
+        std::integral_constant<int, clamp_detail::conversion_of<To, From>::value>() );
+}
+
+// Implementation details of clamp_convert_range():
+
+namespace clamp_detail {
+namespace simd {
+
+// Per kind and size of From and To: width and step(), which converts width
+// elements with pack-with-saturation instructions. Floating point input is
+// clamped to To's range first, as the conversion to int32 does not saturate.
+
+template<int FromKind, std::size_t FromSize, int ToKind, std::size_t ToSize>
+struct convert_of { enum { width = 0 }; };
+
+template<class From, class To>
+struct convert : convert_of< kind_of<From>::value, sizeof(From), kind_of<To>::value, sizeof(To) > {};
+
+#if CLAMP_HAVE_SSE2
+
+struct sse2_convert
+{
+    static __m128i load( void const * p, std::size_t i ) { return _mm_loadu_si128( static_cast<__m128i const *>( p ) + i ); }
+    static void   store( void * p, __m128i v ) { _mm_storeu_si128( static_cast<__m128i *>( p ), v ); }
+
+    // int32 in [0, 65535] to uint16 via signed saturation of v - 32768:
+    static __m128i pack_u16( __m128i a, __m128i b )
+    {
+        __m128i const bias = _mm_set1_epi32( 32768 );
+        return _mm_xor_si128( _mm_packs_epi32( _mm_sub_epi32( a, bias ), _mm_sub_epi32( b, bias ) ), _mm_set1_epi16( -32768 ) );
+    }
+
+    // int32 clamped to [0, 65535]:
+    static __m128i to_uint16_range( __m128i v )
+    {
+        __m128i const hi = _mm_set1_epi32( 65535 );
+#if CLAMP_HAVE_SSE41
+        return _mm_min_epi32( hi, _mm_max_epi32( _mm_setzero_si128(), v ) );
+#else
+        __m128i const pos = _mm_andnot_si128( _mm_srai_epi32( v, 31 ), v );
+        __m128i const gt  = _mm_cmpgt_epi32( pos, hi );
+        return _mm_or_si128( _mm_and_si128( gt, hi ), _mm_andnot_si128( gt, pos ) );
+#endif
+    }
+
+    // float clamped to [lo, hi], NaN to 0, truncated to int32:
+    static __m128i to_int32( void const * p, std::size_t i, float lo, float hi )
+    {
+        __m128 const v = _mm_loadu_ps( static_cast<float const *>( p ) + 4 * i );
+        __m128 const c = _mm_min_ps( _mm_set1_ps( hi ), _mm_max_ps( _mm_set1_ps( lo ), _mm_and_ps( v, _mm_cmpord_ps( v, v ) ) ) );
+        return _mm_cvttps_epi32( c );
+    }
+};
+
+template<> struct convert_of<signed_int, 4, signed_int, 2> : sse2_convert
+{
+    enum { width = 8 };
+    static void step( void const * in, void * out )
+    {
+        store( out, _mm_packs_epi32( load( in, 0 ), load( in, 1 ) ) );
+    }
+};
+
+template<> struct convert_of<signed_int, 4, unsigned_int, 2> : sse2_convert
+{
+    enum { width = 8 };
+    static void step( void const * in, void * out )
+    {
+        store( out, pack_u16( to_uint16_range( load( in, 0 ) ), to_uint16_range( load( in, 1 ) ) ) );
+    }
+};
+
+template<> struct convert_of<signed_int, 4, signed_int, 1> : sse2_convert
+{
+    enum { width = 16 };
+    static void step( void const * in, void * out )
+    {
+        store( out, _mm_packs_epi16( _mm_packs_epi32( load( in, 0 ), load( in, 1 ) ),
+                                     _mm_packs_epi32( load( in, 2 ), load( in, 3 ) ) ) );
+    }
+};
+
+template<> struct convert_of<signed_int, 4, unsigned_int, 1> : sse2_convert
+{
+    enum { width = 16 };
+    static void step( void const * in, void * out )
+    {
+        store( out, _mm_packus_epi16( _mm_packs_epi32( load( in, 0 ), load( in, 1 ) ),
+                                      _mm_packs_epi32( load( in, 2 ), load( in, 3 ) ) ) );
+    }
+};
+
+template<> struct convert_of<signed_int, 2, signed_int, 1> : sse2_convert
+{
+    enum { width = 16 };
+    static void step( void const * in, void * out )
+    {
+        store( out, _mm_packs_epi16( load( in, 0 ), load( in, 1 ) ) );
+    }
+};
+
+template<> struct convert_of<signed_int, 2, unsigned_int, 1> : sse2_convert
+{
+    enum { width = 16 };
+    static void step( void const * in, void * out )
+    {
+        store( out, _mm_packus_epi16( load( in, 0 ), load( in, 1 ) ) );
+    }
+};
+
+template<> struct convert_of<unsigned_int, 2, unsigned_int, 1> : sse2_convert
+{
+    enum { width = 16 };
+    static void step( void const * in, void * out )
+    {
+        // min(v, 255) as v - (v -sat 255), then pack as signed:
+        __m128i const m = _mm_set1_epi16( 255 );
+        __m128i const a = load( in, 0 ), b = load( in, 1 );
+        store( out, _mm_packus_epi16( _mm_sub_epi16( a, _mm_subs_epu16( a, m ) ), _mm_sub_epi16( b, _mm_subs_epu16( b, m ) ) ) );
+    }
+};
+
+template<> struct convert_of<floating, 4, signed_int, 2> : sse2_convert
+{
+    enum { width = 8 };
+    static void step( void const * in, void * out )
+    {
+        store( out, _mm_packs_epi32( to_int32( in, 0, -32768.f, 32767.f ), to_int32( in, 1, -32768.f, 32767.f ) ) );
+    }
+};
+
+template<> struct convert_of<floating, 4, unsigned_int, 2> : sse2_convert
+{
+    enum { width = 8 };
+    static void step( void const * in, void * out )
+    {
+        store( out, pack_u16( to_int32( in, 0, 0.f, 65535.f ), to_int32( in, 1, 0.f, 65535.f ) ) );
+    }
+};
+
+template<> struct convert_of<floating, 4, signed_int, 1> : sse2_convert
+{
+    enum { width = 16 };
+    static void step( void const * in, void * out )
+    {
+        store( out, _mm_packs_epi16( _mm_packs_epi32( to_int32( in, 0, -128.f, 127.f ), to_int32( in, 1, -128.f, 127.f ) ),
+                                     _mm_packs_epi32( to_int32( in, 2, -128.f, 127.f ), to_int32( in, 3, -128.f, 127.f ) ) ) );
+    }
+};
+
+template<> struct convert_of<floating, 4, unsigned_int, 1> : sse2_convert
+{
+    enum { width = 16 };
+    static void step( void const * in, void * out )
+    {
+        store( out, _mm_packus_epi16( _mm_packs_epi32( to_int32( in, 0, 0.f, 255.f ), to_int32( in, 1, 0.f, 255.f ) ),
+                                      _mm_packs_epi32( to_int32( in, 2, 0.f, 255.f ), to_int32( in, 3, 0.f, 255.f ) ) ) );
+    }
+};
+
+template<> struct convert_of<floating, 8, floating, 4>
+{
+    enum { width = 4 };
+
+    // saturate finite values, select the unclamped value for infinities:
+    static __m128 to_float( __m128d v )
+    {
+        __m128d const lo  = _mm_set1_pd( -std::numeric_limits<float>::max() );
+        __m128d const hi  = _mm_set1_pd(  std::numeric_limits<float>::max() );
+        __m128d const inf = _mm_cmpeq_pd( _mm_andnot_pd( _mm_set1_pd( -0.0 ), v ),
+                                          _mm_set1_pd( std::numeric_limits<double>::infinity() ) );
+        return _mm_cvtpd_ps( _mm_or_pd( _mm_and_pd( inf, v ),
+                                        _mm_andnot_pd( inf, _mm_min_pd( hi, _mm_max_pd( lo, v ) ) ) ) );
+    }
+
+    static void step( void const * in, void * out )
+    {
+        double const * const p = static_cast<double const *>( in );
+        _mm_storeu_ps( static_cast<float *>( out ), _mm_movelh_ps( to_float( _mm_loadu_pd( p ) ), to_float( _mm_loadu_pd( p + 2 ) ) ) );
+    }
+};
+
+#endif // CLAMP_HAVE_SSE2
+
+// convert n contiguous elements; the tail is converted per element, as the
+// output may alias the input of a narrowing conversion:
+
+template<class To, class From>
+void convert_n( From const * first, std::size_t n, To * out )
+{
+    typedef convert<From, To> C;
+
+    std::size_t i = 0;
+    for ( ; i + C::width <= n; i += C::width )
+        C::step( first + i, out + i );
+
+    for ( ; i < n; ++i )
+        out[i] = clamp_cast<To>( first[i] );
+}
+
+} // namespace simd
+
+template<class InputIterator, class OutputIterator, class To,
+         class From = typename std::iterator_traits<InputIterator>::value_type>
+struct use_simd_convert : lazy_and< ( simd::convert<From, To>::width > 0 ), std::integral_constant<bool,
+    is_contiguous_input<InputIterator, From>::value &&
+    is_contiguous_output<OutputIterator, To>::value > > {};
+
+template<class To, class InputIterator, class OutputIterator>
+OutputIterator clamp_convert_range( InputIterator first, InputIterator last, OutputIterator out, std::false_type )
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type from_type;
+
+    return std::transform( first, last, out, []( from_type const & val ) { return clamp_cast<To>( val ); } );
+}
+
+template<class To, class InputIterator, class OutputIterator>
+OutputIterator clamp_convert_range( InputIterator first, InputIterator last, OutputIterator out, std::true_type )
+{
+    auto const n = std::distance( first, last );
+
+    if ( n <= 0 )
+        return out;
+
+    simd::convert_n<To>( std::addressof( *first ), static_cast<std::size_t>( n ), std::addressof( *out ) );
+
+    return out + n;
+}
+
+} // namespace clamp_detail
+
+// convert range of values, saturating:
+
+template<class To, class InputIterator, class OutputIterator>
+OutputIterator clamp_convert_range( InputIterator first, InputIterator last, OutputIterator out )
+{
+    typedef typename std::conditional< std::is_void<To>::value,
+        typename std::iterator_traits<OutputIterator>::value_type, To >::type to_type;
+
+    return clamp_detail::clamp_convert_range<to_type>( first, last, out,
+        clamp_detail::use_simd_convert<InputIterator, OutputIterator, to_type>() );
+}
+
+// Implementation details of clamp_stream():
+
+namespace clamp_detail {
+
+// untie input stream from output stream, as the reading thread would flush it:
+
+class untie_guard
+{
+public:
+    explicit untie_guard( std::istream & in )
+    : in( in ), tied( in.tie( nullptr ) )
+    {
+        if ( tied )
+            tied->flush();
+    }
+
+    ~untie_guard()
+    {
+        in.tie( tied );
+    }
+
+private:
+    untie_guard( untie_guard const & ) = delete;
+    untie_guard & operator=( untie_guard const & ) = delete;
+
+    std::istream & in;
+    std::ostream * tied;
+};
+
+// read up to n bytes, return the number of bytes read:
+
+inline std::size_t read_bytes( std::istream & in, char * p, std::size_t n )
+{
+    in.read( p, static_cast<std::streamsize>( n ) );
+    return static_cast<std::size_t>( in.gcount() );
+}
+
+// one reading thread for the whole stream; chunk k is read into buffer k % 2,
+// once the caller released chunk k - 2, so the two buffers alternate between
+// the reader and the caller; an exception while reading is rethrown by wait():
+
+template<class T>
+class stream_reader
+{
+public:
+    stream_reader( std::istream & in, std::size_t chunk_size )
+    : in( in ), chunk_bytes( chunk_size * sizeof(T) )
+    , buffers{ { std::vector<T>( chunk_size ), std::vector<T>( chunk_size ) } }, sizes{ { 0, 0 } }
+    , filled( 0 ), released( 0 ), done( false ), stopping( false ), error(), mutex(), changed()
+    , reader( [this]{ run(); } )
+    {}
+
+    ~stream_reader()
+    {
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            stopping = true;
+        }
+        changed.notify_all();
+        reader.join();
+    }
+
+    // wait for chunk k, return its data and its size in bytes, 0 at the end:
+
+    std::size_t wait( std::size_t k, T *& data )
+    {
+        std::unique_lock<std::mutex> lock( mutex );
+        changed.wait( lock, [&]{ return k < filled || done; } );
+
+        if ( k >= filled && error )
+            std::rethrow_exception( error );
+
+        data = buffers[ k % 2 ].data();
+        return k < filled ? sizes[ k % 2 ] : 0;
+    }
+
+    // hand the buffer of the oldest unreleased chunk back to the reader:
+
+    void release()
+    {
+        {
+            std::lock_guard<std::mutex> lock( mutex );
+            ++released;
+        }
+        changed.notify_all();
+    }
+
+private:
+    stream_reader( stream_reader const & ) = delete;
+    stream_reader & operator=( stream_reader const & ) = delete;
+
+    void run()
+    {
+        for ( std::size_t k = 0; ; ++k )
+        {
+            {
+                std::unique_lock<std::mutex> lock( mutex );
+                changed.wait( lock, [&]{ return stopping || k < released + 2; } );
+
+                if ( stopping )
+                    return;
+            }
+
+            std::size_t bytes = 0;
+            std::exception_ptr failure;
+
+            try { bytes = read_bytes( in, reinterpret_cast<char *>( buffers[ k % 2 ].data() ), chunk_bytes ); }
+            catch ( ... ) { failure = std::current_exception(); }
+
+            bool const last = failure || bytes < chunk_bytes;
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                if ( failure )
+                {
+                    error = failure;
+                }
+                else
+                {
+                    sizes[ k % 2 ] = bytes;
+                    filled = k + 1;
+                }
+                done = last;
+            }
+            changed.notify_all();
+
+            if ( last )
+                return;
+        }
+    }
+
+    std::istream & in;
+    std::size_t const chunk_bytes;
+    std::array<std::vector<T>, 2> buffers;
+    std::array<std::size_t, 2> sizes;
+    std::size_t filled;
+    std::size_t released;
+    bool done;
+    bool stopping;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::thread reader;
+};
+
+} // namespace clamp_detail
+
+// clamp binary stream of values; trailing bytes that do not form a complete
+// value are copied unchanged:
+
+template<class T, class Compare>
+std::size_t clamp_stream( std::istream & in, std::ostream & out, T const& lo, T const& hi,
+    Compare comp, std::size_t chunk_size )
+{
+    static_assert( std::is_trivially_copyable<T>::value, "clamp_stream: expect trivially copyable type" );
+
+    assert( chunk_size > 0 );
+
+    clamp_detail::untie_guard const guard( in );
+    clamp_detail::stream_reader<T> reader( in, chunk_size );
+
+    std::size_t written = 0;
+
+    for ( std::size_t k = 0; ; ++k )
+    {
+        T * data = nullptr;
+        std::size_t const bytes = reader.wait( k, data );
+
+        if ( bytes == 0 )
+            break;
+
+        std::size_t const n = bytes / sizeof(T);
+
+        clamp_range( data, data + n, data, lo, hi, comp );
+
+        if ( !out.write( reinterpret_cast<char const *>( data ), static_cast<std::streamsize>( bytes ) ) )
+            break;
+
+        written += n;
+        reader.release();
+    }
+
+    return written;
+}
+
+// Implementation details of clamp_range_each():
+
+namespace clamp_detail {
+
+// bound for all elements, or bound per element from an iterator; at(i) and
+// load(i) access the bound of the i-th element of a contiguous range:
+
+template<class T>
+struct value_bound
+{
+    T value;
+
+    T const & operator*() const { return value; }
+    value_bound & operator++() { return *this; }
+
+    T at( std::size_t ) const { return value; }
+};
+
+template<class It>
+struct iterator_bound
+{
+    It it;
+
+    auto operator*() const -> decltype( *it ) { return *it; }
+    iterator_bound & operator++() { ++it; return *this; }
+
+    typename std::iterator_traits<It>::value_type at( std::size_t i ) const { return it[i]; }
+};
+
+template<class T, class B>
+struct is_value_bound : std::is_convertible<B, T> {};
+
+template<class T, class B>
+value_bound<T> make_bound( B const & b, std::true_type /*value*/ )
+{
+    return value_bound<T>{ b };
+}
+
+template<class T, class B>
+iterator_bound<B> make_bound( B const & b, std::false_type )
+{
+    return iterator_bound<B>{ b };
+}
+
+namespace simd {
+
+template<class T, class V = ops<T>>
+typename V::reg load( value_bound<T> const &, typename V::reg value, std::size_t )
+{
+    return value;
+}
+
+template<class T, class It, class V = ops<T>>
+typename V::reg load( iterator_bound<It> const & b, typename V::reg, std::size_t i )
+{
+    return V::loadu( std::addressof( b.it[i] ) );
+}
+
+template<class T, class B>
+typename ops<T>::reg broadcast( B const & b, std::true_type /*value*/ )
+{
+    return ops<T>::set1( b.value );
+}
+
+template<class T, class B>
+typename ops<T>::reg broadcast( B const &, std::false_type )
+{
+    return typename ops<T>::reg();
+}
+
+template<class T>
+struct is_value : std::false_type {};
+
+template<class T>
+struct is_value< value_bound<T> > : std::true_type {};
+
+// clamp n contiguous elements to per-element [lo, hi] with std::less<>:
+
+template<class T, class Lo, class Hi>
+void clamp_n_each( T const * first, std::size_t n, T * out, Lo const & lo, Hi const & hi )
+{
+    typedef ops<T> V;
+    std::size_t const w = V::width;
+
+    auto const vlo = broadcast<T>( lo, is_value<Lo>() );
+    auto const vhi = broadcast<T>( hi, is_value<Hi>() );
+
+    std::size_t i = 0;
+    for ( ; i + w <= n; i += w )
+    {
+        V::storeu( out + i, V::min( load<T>( hi, vhi, i ), V::max( load<T>( lo, vlo, i ), V::loadu( first + i ) ) ) );
+    }
+
+    for ( ; i < n; ++i )
+        out[i] = clamp_value( first[i], lo.at( i ), hi.at( i ) );
+}
+
+} // namespace simd
+
+// bounds for the SIMD kernels are values or contiguous iterators over T:
+
+template<class T, class B>
+struct is_simd_bound : std::integral_constant<bool,
+    is_value_bound<T, B>::value || is_contiguous_input<B, T>::value > {};
+
+template<class InputIterator, class OutputIterator, class Lo, class Hi, class Compare,
+         class T = typename std::iterator_traits<InputIterator>::value_type>
+struct use_simd_each : lazy_and< use_simd<InputIterator, OutputIterator, Compare>::value, std::integral_constant<bool,
+    is_simd_bound<T, Lo>::value && is_simd_bound<T, Hi>::value > > {};
+
+// generic clamp_range_each():
+
+template<class InputIterator, class OutputIterator, class Lo, class Hi, class Compare>
+OutputIterator clamp_range_each( InputIterator first, InputIterator last, OutputIterator out,
+    Lo lo, Hi hi, Compare comp, std::false_type )
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    for ( ; first != last; ++first, ++out, ++lo, ++hi )
+    {
+        *out = clamp_fast<T>( *first, *lo, *hi, comp, std::is_arithmetic<T>() );
+    }
+    return out;
+}
+
+// SIMD clamp_range_each(), clamping to [hi, lo] for greater is equivalent:
+
+template<class InputIterator, class OutputIterator, class Lo, class Hi, class Compare>
+OutputIterator clamp_range_each( InputIterator first, InputIterator last, OutputIterator out,
+    Lo lo, Hi hi, Compare comp, std::true_type )
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    auto const n = std::distance( first, last );
+
+    if ( n <= 0 )
+        return out;
+
+#ifndef NDEBUG
+    for ( std::size_t i = 0; i != std::size_t( n ); ++i )
+        assert( !comp( hi.at( i ), lo.at( i ) ) );
+#endif
+    (void) comp;
+
+    auto const src = std::addressof( *first );
+    auto const dst = std::addressof( *out );
+
+    if ( is_greater<Compare, T>::value )
+        simd::clamp_n_each( src, static_cast<std::size_t>( n ), dst, hi, lo );
+    else
+        simd::clamp_n_each( src, static_cast<std::size_t>( n ), dst, lo, hi );
+
+    return out + n;
+}
+
+} // namespace clamp_detail
+
+// clamp range of values to per-element bounds:
+
+template<class InputIterator, class OutputIterator, class Lo, class Hi, class Compare>
+OutputIterator clamp_range_each( InputIterator first, InputIterator last, OutputIterator out,
+    Lo lo, Hi hi, Compare comp )
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    return clamp_detail::clamp_range_each( first, last, out,
+        clamp_detail::make_bound<T>( lo, clamp_detail::is_value_bound<T, Lo>() ),
+        clamp_detail::make_bound<T>( hi, clamp_detail::is_value_bound<T, Hi>() ), comp,
+        clamp_detail::use_simd_each<InputIterator, OutputIterator, Lo, Hi, Compare>() );
+}
+
+// Implementation details of clamp_range_count():
+
+namespace clamp_detail {
+namespace simd {
+
+// clamp n contiguous elements to [lo, hi], lo < hi, with std::less<> and count
+// the values below lo and above hi. A clamped value c equals lo for each value
+// v below lo or equal to lo, so that #(v < lo) == #(c == lo) - #(v == lo):
+
+template<class T>
+void clamp_n_count( T const * first, std::size_t n, T * out, T const lo, T const hi,
+    std::size_t & below, std::size_t & above )
+{
+    typedef ops<T> V;
+    std::size_t const w = V::width;
+
+    auto const vlo = V::set1( lo );
+    auto const vhi = V::set1( hi );
+
+    std::ptrdiff_t lo_count = 0, hi_count = 0;
+
+    std::size_t i = 0;
+    for ( ; i + w <= n; i += w )
+    {
+        auto const v = V::loadu( first + i );
+        auto const c = V::min( vhi, V::max( vlo, v ) );
+
+        V::storeu( out + i, c );
+
+        lo_count += V::count_eq( c, vlo ) - V::count_eq( v, vlo );
+        hi_count += V::count_eq( c, vhi ) - V::count_eq( v, vhi );
+    }
+
+    for ( ; i < n; ++i )
+    {
+        T const v = first[i];
+
+        lo_count += v < lo;
+        hi_count += hi < v;
+
+        out[i] = clamp_value( v, lo, hi );
+    }
+
+    below += static_cast<std::size_t>( lo_count );
+    above += static_cast<std::size_t>( hi_count );
+}
+
+} // namespace simd
+
+// generic clamp_range_count():
+
+template<class InputIterator, class OutputIterator, class T, class Compare>
+clamp_count_result<OutputIterator> clamp_range_count( InputIterator first, InputIterator last, OutputIterator out,
+    T const& lo, T const& hi, Compare comp, std::false_type )
+{
+    assert( !comp(hi, lo) );
+
+    clamp_count_result<OutputIterator> result{ out, 0, 0 };
+
+    for ( ; first != last; ++first, ++result.out )
+    {
+        auto && val = *first;
+
+        if      ( comp(val, lo) ) { *result.out = lo; ++result.below; }
+        else if ( comp(hi, val) ) { *result.out = hi; ++result.above; }
+        else                      { *result.out = val; }
+    }
+    return result;
+}
+
+// SIMD clamp_range_count(), clamping to [hi, lo] for greater is equivalent;
+// for lo equivalent to hi, the counts do not follow from the clamped values:
+
+template<class InputIterator, class OutputIterator, class T, class Compare>
+clamp_count_result<OutputIterator> clamp_range_count( InputIterator first, InputIterator last, OutputIterator out,
+    T const& lo, T const& hi, Compare comp, std::true_type )
+{
+    assert( !comp(hi, lo) );
+
+    auto const n = std::distance( first, last );
+
+    if ( n <= 0 || !comp(lo, hi) )
+        return clamp_range_count( first, last, out, lo, hi, comp, std::false_type() );
+
+    auto const src = std::addressof( *first );
+    auto const dst = std::addressof( *out );
+
+    clamp_count_result<OutputIterator> result{ out + n, 0, 0 };
+
+    if ( is_greater<Compare, T>::value )
+        simd::clamp_n_count<T>( src, static_cast<std::size_t>( n ), dst, hi, lo, result.above, result.below );
+    else
+        simd::clamp_n_count<T>( src, static_cast<std::size_t>( n ), dst, lo, hi, result.below, result.above );
+
+    return result;
+}
+
+} // namespace clamp_detail
+
+// clamp range of values and count the values clamped:
+
+template<class InputIterator, class OutputIterator, class Compare>
+clamp_count_result<OutputIterator> clamp_range_count( InputIterator first, InputIterator last, OutputIterator out,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp )
+{
+    return clamp_detail::clamp_range_count( first, last, out, lo, hi, comp,
+        clamp_detail::use_simd<InputIterator, OutputIterator, Compare>() );
+}
+
+// Implementation details of clamp_reduce() and clamp_sum():
+
+namespace clamp_detail {
+namespace simd {
+
+// sum n contiguous elements clamped to [lo, hi] with std::less<>: clamp blocks
+// that stay in L1 cache, then add them with independent accumulators:
+
+template<class Acc, class T>
+Acc clamp_sum_n( T const * first, std::size_t n, T const lo, T const hi )
+{
+    std::size_t const block = 1024;
+
+    T buf[ block ];
+    Acc acc[4] = { Acc(0), Acc(0), Acc(0), Acc(0) };
+
+    for ( std::size_t i = 0; i < n; i += block )
+    {
+        std::size_t const m = std::min( block, n - i );
+
+        clamp_n( first + i, m, buf, lo, hi );
+
+        std::size_t j = 0;
+        for ( ; j + 4 <= m; j += 4 )
+        {
+            acc[0] += buf[j]; acc[1] += buf[j + 1]; acc[2] += buf[j + 2]; acc[3] += buf[j + 3];
+        }
+        for ( ; j < m; ++j )
+            acc[0] += buf[j];
+    }
+    return ( acc[0] + acc[1] ) + ( acc[2] + acc[3] );
+}
+
+} // namespace simd
+
+// generic and SIMD clamp_sum():
+
+template<class InputIterator, class T, class Compare>
+typename clamp_sum_type<T>::type clamp_sum( InputIterator first, InputIterator last,
+    T const& lo, T const& hi, Compare comp, std::false_type )
+{
+    typedef typename clamp_sum_type<T>::type acc_type;
+
+    return clamp_reduce( first, last, lo, hi, acc_type(0),
+        []( acc_type acc, T val ) { return acc + val; }, comp );
+}
+
+template<class InputIterator, class T, class Compare>
+typename clamp_sum_type<T>::type clamp_sum( InputIterator first, InputIterator last,
+    T const& lo, T const& hi, Compare comp, std::true_type )
+{
+    typedef typename clamp_sum_type<T>::type acc_type;
+
+    assert( !comp(hi, lo) ); (void) comp;
+
+    auto const n = std::distance( first, last );
+
+    if ( n <= 0 )
+        return acc_type(0);
+
+    auto const src = std::addressof( *first );
+
+    return is_greater<Compare, T>::value
+        ? simd::clamp_sum_n<acc_type>( src, static_cast<std::size_t>( n ), hi, lo )
+        : simd::clamp_sum_n<acc_type>( src, static_cast<std::size_t>( n ), lo, hi );
+}
+
+// SIMD sums need contiguous arithmetic input only; clamp_half and
+// clamp_bfloat16 are summed per element as float:
+
+template<class InputIterator, class Compare,
+         class T = typename std::iterator_traits<InputIterator>::value_type>
+struct use_simd_reduce : lazy_and< std::is_arithmetic<T>::value, use_simd<InputIterator, T *, Compare> > {};
+
+template<class T>
+struct is_summable : std::integral_constant<bool, std::is_arithmetic<T>::value ||
+    std::is_same<T, clamp_half>::value || std::is_same<T, clamp_bfloat16>::value> {};
+
+// parallel clamp_sum(): sum chunks on the thread pool, then add the sums:
+
+template<class InputIterator, class T, class Compare>
+typename clamp_sum_type<T>::type parallel_clamp_sum( InputIterator first, InputIterator last,
+    T const& lo, T const& hi, Compare comp, std::true_type )
+{
+    typedef typename clamp_sum_type<T>::type acc_type;
+    typedef typename std::iterator_traits<InputIterator>::difference_type diff_t;
+
+    diff_t const n = std::distance( first, last );
+
+    if ( n < diff_t( CLAMP_PARALLEL_THRESHOLD ) || thread_pool::instance().size() == 0 )
+        return ::clamp_sum( first, last, lo, hi, comp );
+
+    diff_t const min_chunk = diff_t( CLAMP_PARALLEL_THRESHOLD ) / 2;
+    diff_t const max_count = diff_t( 4 * ( thread_pool::instance().size() + 1 ) );
+    diff_t const count     = std::min( max_count, n / min_chunk );
+    diff_t const chunk     = ( n + count - 1 ) / count;
+
+    std::vector<acc_type> sums( static_cast<std::size_t>( ( n + chunk - 1 ) / chunk ) );
+
+    parallel_for( sums.size(), [=, &sums]( std::size_t i )
+    {
+        diff_t const pos = diff_t( i ) * chunk;
+        diff_t const len = std::min( chunk, n - pos );
+
+        sums[i] = ::clamp_sum( first + pos, first + pos + len, lo, hi, comp );
+    });
+
+    return std::accumulate( sums.begin(), sums.end(), acc_type(0) );
+}
+
+template<class InputIterator, class T, class Compare>
+typename clamp_sum_type<T>::type parallel_clamp_sum( InputIterator first, InputIterator last,
+    T const& lo, T const& hi, Compare comp, std::false_type )
+{
+    return ::clamp_sum( first, last, lo, hi, comp );
+}
+
+template<class InputIterator, class T, class Compare>
+typename clamp_sum_type<T>::type clamp_sum( clamp_execution::sequenced_policy,
+    InputIterator first, InputIterator last, T const& lo, T const& hi, Compare comp )
+{
+    return ::clamp_sum( first, last, lo, hi, comp );
+}
+
+template<class InputIterator, class T, class Compare>
+typename clamp_sum_type<T>::type clamp_sum( clamp_execution::parallel_policy,
+    InputIterator first, InputIterator last, T const& lo, T const& hi, Compare comp )
+{
+    return parallel_clamp_sum( first, last, lo, hi, comp, is_random_access<InputIterator>() );
+}
+
+template<class InputIterator, class T, class Compare>
+typename clamp_sum_type<T>::type clamp_sum( clamp_execution::parallel_unsequenced_policy,
+    InputIterator first, InputIterator last, T const& lo, T const& hi, Compare comp )
+{
+    return parallel_clamp_sum( first, last, lo, hi, comp, is_random_access<InputIterator>() );
+}
+
+template<class Acc>
+double mean_of( Acc sum, std::size_t n )
+{
+    return n > 0 ? static_cast<double>( sum ) / static_cast<double>( n ) : std::numeric_limits<double>::quiet_NaN();
+}
+
+// clamp_mean() in a single pass: a random-access range is counted with
+// last - first, so that clamp_sum() keeps its SIMD kernels and thread pool;
+// another range is summed and counted in the same loop:
+
+template<class RandomAccessIterator, class T, class Compare>
+double clamp_mean( RandomAccessIterator first, RandomAccessIterator last,
+    T const& lo, T const& hi, Compare comp, std::true_type )
+{
+    return mean_of( ::clamp_sum( first, last, lo, hi, comp ), static_cast<std::size_t>( last - first ) );
+}
+
+template<class InputIterator, class T, class Compare>
+double clamp_mean( InputIterator first, InputIterator last,
+    T const& lo, T const& hi, Compare comp, std::false_type )
+{
+    typedef std::pair<typename clamp_sum_type<T>::type, std::size_t> acc_type;
+
+    acc_type const acc = clamp_reduce( first, last, lo, hi, acc_type(),
+        []( acc_type acc, T val ) { return acc_type( acc.first + val, acc.second + 1 ); }, comp );
+
+    return mean_of( acc.first, acc.second );
+}
+
+template<class ExecutionPolicy, class RandomAccessIterator, class T, class Compare>
+double clamp_mean( ExecutionPolicy policy, RandomAccessIterator first, RandomAccessIterator last,
+    T const& lo, T const& hi, Compare comp, std::true_type )
+{
+    return mean_of( clamp_sum( policy, first, last, lo, hi, comp ), static_cast<std::size_t>( last - first ) );
+}
+
+template<class ExecutionPolicy, class InputIterator, class T, class Compare>
+double clamp_mean( ExecutionPolicy, InputIterator first, InputIterator last,
+    T const& lo, T const& hi, Compare comp, std::false_type )
+{
+    return clamp_mean( first, last, lo, hi, comp, std::false_type() );
+}
+
+} // namespace clamp_detail
+
+// reduce range of clamped values:
+
+template<class InputIterator, class T, class BinaryOperation, class Compare>
+T clamp_reduce( InputIterator first, InputIterator last,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, T init, BinaryOperation op, Compare comp )
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+    for ( ; first != last; ++first )
+    {
+        init = op( std::move( init ), clamp_detail::clamp_fast<value_type>( *first, lo, hi, comp, std::is_arithmetic<value_type>() ) );
+    }
+    return init;
+}
+
+// sum, mean, minimum and maximum of range of clamped values:
+
+template<class InputIterator, class Compare>
+typename clamp_sum_type<typename std::iterator_traits<InputIterator>::value_type>::type
+clamp_sum( InputIterator first, InputIterator last,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp )
+{
+    static_assert( clamp_detail::is_summable<typename std::iterator_traits<InputIterator>::value_type>::value,
+        "clamp_sum: expect arithmetic, clamp_half or clamp_bfloat16 type, use clamp_reduce() for other types" );
+
+    return clamp_detail::clamp_sum( first, last, lo, hi, comp,
+        clamp_detail::use_simd_reduce<InputIterator, Compare>() );
+}
+
+template<class InputIterator, class Compare>
+double clamp_mean( InputIterator first, InputIterator last,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp )
+{
+    static_assert( clamp_detail::is_summable<typename std::iterator_traits<InputIterator>::value_type>::value,
+        "clamp_mean: expect arithmetic, clamp_half or clamp_bfloat16 type, use clamp_reduce() for other types" );
+
+    return clamp_detail::clamp_mean( first, last, lo, hi, comp, clamp_detail::is_random_access<InputIterator>() );
+}
+
+// clamp() is monotonic, so the extreme of the clamped values is the clamped
+// extreme of the values:
+
+template<class InputIterator, class Compare>
+typename std::iterator_traits<InputIterator>::value_type
+clamp_min( InputIterator first, InputIterator last,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp )
+{
+    assert( first != last );
+
+    return clamp( *std::min_element( first, last, comp ), lo, hi, comp );
+}
+
+template<class InputIterator, class Compare>
+typename std::iterator_traits<InputIterator>::value_type
+clamp_max( InputIterator first, InputIterator last,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp )
+{
+    assert( first != last );
+
+    return clamp( *std::max_element( first, last, comp ), lo, hi, comp );
+}
+
+// sum and mean per execution policy:
+
+template<class ExecutionPolicy, class InputIterator, class Compare>
+typename clamp_execution::enable_if_policy<ExecutionPolicy,
+    typename clamp_sum_type<typename std::iterator_traits<InputIterator>::value_type>::type>::type
+clamp_sum( ExecutionPolicy&& policy, InputIterator first, InputIterator last,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp )
+{
+    return clamp_detail::clamp_sum(
+        typename std::decay<ExecutionPolicy>::type( policy ), first, last, lo, hi, comp );
+}
+
+template<class ExecutionPolicy, class InputIterator, class Compare>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, double>::type
+clamp_mean( ExecutionPolicy&& policy, InputIterator first, InputIterator last,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp )
+{
+    return clamp_detail::clamp_mean( typename std::decay<ExecutionPolicy>::type( policy ),
+        first, last, lo, hi, comp, clamp_detail::is_random_access<InputIterator>() );
+}
+
+// Implementation details of clamp_range_channels():
+
+namespace clamp_detail {
+namespace simd {
+
+// clamp n contiguous elements of N interleaved channels to per-channel
+// [lo, hi] with std::less<>. A block of N registers holds a whole number of
+// pixels, so that its bounds are N fixed registers with the repeated bound
+// pattern, and no shuffles are needed:
+
+template<std::size_t N, class T>
+void clamp_n_channels( T const * first, std::size_t n, T * out, std::array<T, N> const& lo, std::array<T, N> const& hi )
+{
+    typedef ops<T> V;
+    std::size_t const w = V::width;
+    std::size_t const block = N * w;
+
+    typename V::reg vlo[N], vhi[N];
+    {
+        T plo[ N * V::width ], phi[ N * V::width ];
+
+        for ( std::size_t i = 0; i < block; ++i )
+        {
+            plo[i] = lo[ i % N ];
+            phi[i] = hi[ i % N ];
+        }
+        for ( std::size_t k = 0; k < N; ++k )
+        {
+            vlo[k] = V::loadu( plo + k * w );
+            vhi[k] = V::loadu( phi + k * w );
+        }
+    }
+
+    std::size_t i = 0;
+    for ( ; i + block <= n; i += block )
+    {
+        for ( std::size_t k = 0; k < N; ++k )
+            V::storeu( out + i + k * w, V::min( vhi[k], V::max( vlo[k], V::loadu( first + i + k * w ) ) ) );
+    }
+
+    for ( ; i < n; ++i )
+        out[i] = clamp_value( first[i], lo[ i % N ], hi[ i % N ] );
+}
+
+} // namespace simd
+
+// SIMD kernels for 2, 3 and 4 channels:
+
+template<class InputIterator, class OutputIterator, std::size_t N, class Compare>
+struct use_simd_channels : lazy_and< ( N >= 2 && N <= 4 ), use_simd<InputIterator, OutputIterator, Compare> > {};
+
+// generic clamp_range_channels():
+
+template<class InputIterator, class OutputIterator, class T, std::size_t N, class Compare>
+OutputIterator clamp_range_channels( InputIterator first, InputIterator last, OutputIterator out,
+    std::array<T, N> const& lo, std::array<T, N> const& hi, Compare comp, std::false_type )
+{
+    for ( std::size_t c = 0; first != last; ++first, ++out )
+    {
+        *out = clamp_fast<T>( *first, lo[c], hi[c], comp, std::is_arithmetic<T>() );
+
+        if ( ++c == N )
+            c = 0;
+    }
+    return out;
+}
+
+// SIMD clamp_range_channels(), clamping to [hi, lo] for greater is equivalent:
+
+template<class InputIterator, class OutputIterator, class T, std::size_t N, class Compare>
+OutputIterator clamp_range_channels( InputIterator first, InputIterator last, OutputIterator out,
+    std::array<T, N> const& lo, std::array<T, N> const& hi, Compare comp, std::true_type )
+{
+    auto const n = std::distance( first, last );
+
+    if ( n <= 0 )
+        return out;
+
+    auto const src = std::addressof( *first );
+    auto const dst = std::addressof( *out );
+
+    if ( is_greater<Compare, T>::value )
+        simd::clamp_n_channels<N>( src, static_cast<std::size_t>( n ), dst, hi, lo );
+    else
+        simd::clamp_n_channels<N>( src, static_cast<std::size_t>( n ), dst, lo, hi );
+
+    (void) comp;
+    return out + n;
+}
+
+} // namespace clamp_detail
+
+// clamp range of interleaved channels to bounds per channel:
+
+template<class InputIterator, class OutputIterator, std::size_t N, class Compare>
+OutputIterator clamp_range_channels( InputIterator first, InputIterator last, OutputIterator out,
+    std::array<typename std::iterator_traits<InputIterator>::value_type, N> const& lo,
+    std::array<typename std::iterator_traits<InputIterator>::value_type, N> const& hi, Compare comp )
+{
+    static_assert( N > 0, "clamp_range_channels: expect at least one channel" );
+
+    for ( std::size_t c = 0; c != N; ++c )
+        assert( !comp( hi[c], lo[c] ) );
+
+    return clamp_detail::clamp_range_channels( first, last, out, lo, hi, comp,
+        clamp_detail::use_simd_channels<InputIterator, OutputIterator, N, Compare>() );
+}
+
+// Implementation details of clamp_range_2d():
+
+template<class T>
+pitched_view<T> make_pitched_view( T * base, std::size_t width, std::size_t height, std::ptrdiff_t pitch, std::ptrdiff_t stride )
+{
+    return { base, width, height, pitch, stride };
+}
+
+namespace clamp_detail {
+
+// clamp rows [first, last); rows with contiguous elements use clamp_range():
+
+template<class T, class Compare>
+void clamp_rows( pitched_view<T const> in, pitched_view<T> out, std::size_t first, std::size_t last,
+    T const& lo, T const& hi, Compare comp )
+{
+    for ( std::size_t y = first; y != last; ++y )
+    {
+        T const * src = in.row( y );
+        T       * dst = out.row( y );
+
+        if ( in.stride == 1 && out.stride == 1 )
+        {
+            ::clamp_range( src, src + in.width, dst, lo, hi, comp );
+        }
+        else
+        {
+            for ( std::size_t x = 0; x != in.width; ++x, src += in.stride, dst += out.stride )
+                *dst = clamp_fast<T>( *src, lo, hi, comp, std::is_arithmetic<T>() );
+        }
+    }
+}
+
+// clamp blocks of at least half the threshold elements, about four blocks per
+// thread:
+
+template<class T, class Compare>
+void parallel_clamp_range_2d( pitched_view<T const> in, pitched_view<T> out, T const& lo, T const& hi, Compare comp )
+{
+    std::size_t const n = in.width * in.height;
+
+    if ( n < std::size_t( CLAMP_PARALLEL_THRESHOLD ) || in.height < 2 || thread_pool::instance().size() == 0 )
+        return clamp_rows( in, out, 0, in.height, lo, hi, comp );
+
+    std::size_t const min_rows  = std::max<std::size_t>( 1, std::size_t( CLAMP_PARALLEL_THRESHOLD ) / 2 / in.width );
+    std::size_t const max_count = 4 * ( thread_pool::instance().size() + 1 );
+    std::size_t const count     = std::max<std::size_t>( 1, std::min( max_count, in.height / min_rows ) );
+    std::size_t const rows      = ( in.height + count - 1 ) / count;
+
+    parallel_for( ( in.height + rows - 1 ) / rows, [=]( std::size_t i )
+    {
+        clamp_rows( in, out, i * rows, std::min( in.height, ( i + 1 ) * rows ), lo, hi, comp );
+    });
+}
+
+template<class T, class Compare>
+void clamp_range_2d( clamp_execution::sequenced_policy,
+    pitched_view<T const> in, pitched_view<T> out, T const& lo, T const& hi, Compare comp )
+{
+    clamp_rows( in, out, 0, in.height, lo, hi, comp );
+}
+
+template<class T, class Compare>
+void clamp_range_2d( clamp_execution::parallel_policy,
+    pitched_view<T const> in, pitched_view<T> out, T const& lo, T const& hi, Compare comp )
+{
+    parallel_clamp_range_2d( in, out, lo, hi, comp );
+}
+
+template<class T, class Compare>
+void clamp_range_2d( clamp_execution::parallel_unsequenced_policy,
+    pitched_view<T const> in, pitched_view<T> out, T const& lo, T const& hi, Compare comp )
+{
+    parallel_clamp_range_2d( in, out, lo, hi, comp );
+}
+
+} // namespace clamp_detail
+
+// clamp 2D region:
+
+template<class T, class Compare>
+void clamp_range_2d( pitched_view<typename std::add_const<T>::type> in, pitched_view<T> out,
+    typename pitched_view<T>::value_type const& lo,
+    typename pitched_view<T>::value_type const& hi, Compare comp )
+{
+    assert( in.width == out.width && in.height == out.height );
+
+    clamp_detail::clamp_rows<typename pitched_view<T>::value_type>( in, out, 0, in.height, lo, hi, comp );
+}
+
+// clamp 2D region per execution policy:
+
+template<class ExecutionPolicy, class T, class Compare>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, void>::type
+clamp_range_2d( ExecutionPolicy&& policy, pitched_view<typename std::add_const<T>::type> in, pitched_view<T> out,
+    typename pitched_view<T>::value_type const& lo,
+    typename pitched_view<T>::value_type const& hi, Compare comp )
+{
+    assert( in.width == out.width && in.height == out.height );
+
+    clamp_detail::clamp_range_2d<typename pitched_view<T>::value_type>(
+        typename std::decay<ExecutionPolicy>::type( policy ), in, out, lo, hi, comp );
+}
+
+// Implementation details of clamp() and clamp_range() with compile-time bounds:
+
+namespace clamp_detail {
+
+// value of bound Tag as T, and whether T represents it exactly:
+
+template<class Tag, class T>
+struct bound_of
+{
+    typedef typename std::remove_cv<decltype( Tag::value )>::type value_type;
+
+    static constexpr T value() { return static_cast<T>( Tag::value ); }
+    static constexpr bool exact() { return static_cast<value_type>( value() ) == Tag::value; }
+};
+
+// a ratio is exact for an integral T only if it is a whole number in T's
+// range, as the division would truncate:
+
+template<std::intmax_t Num, std::intmax_t Den, class T>
+struct bound_of<std::ratio<Num, Den>, T>
+{
+    typedef bound_of<std::integral_constant<std::intmax_t, Num / Den>, T> whole;
+
+    static constexpr T value() { return static_cast<T>( Num ) / static_cast<T>( Den ); }
+    static constexpr bool exact() { return !std::is_integral<T>::value || ( Num % Den == 0 && whole::exact() ); }
+};
+
+// a bound needs a comparison unless it is the limit of an integral T:
+
+template<class Lo, class Hi, class T>
+struct const_bounds
+{
+    typedef bound_of<Lo, T> lo;
+    typedef bound_of<Hi, T> hi;
+
+    typedef std::integral_constant<bool, !std::is_integral<T>::value || lo::value() != std::numeric_limits<T>::min()> need_lo;
+    typedef std::integral_constant<bool, !std::is_integral<T>::value || hi::value() != std::numeric_limits<T>::max()> need_hi;
+};
+
+template<class T>
+constexpr T clamp_const( T const& val, T const& lo, T const& hi, std::true_type, std::true_type )
+{
+    return clamp_value( val, lo, hi );
+}
+
+template<class T>
+constexpr T clamp_const( T const& val, T const& lo, T const&, std::true_type, std::false_type )
+{
+    return std14::less<>()( val, lo ) ? lo : val;
+}
+
+template<class T>
+constexpr T clamp_const( T const& val, T const&, T const& hi, std::false_type, std::true_type )
+{
+    return clamp_hi( val, hi, std14::less<>() );
+}
+
+template<class T>
+constexpr T clamp_const( T const& val, T const&, T const&, std::false_type, std::false_type )
+{
+    return val;
+}
+
+namespace simd {
+
+// clamp n contiguous elements to [lo, hi] with std::less<>, comparing only to
+// the bounds needed:
+
+template<bool NeedLo, bool NeedHi, class T>
+void clamp_n_const( T const * first, std::size_t n, T * out, T const lo, T const hi )
+{
+    typedef ops<T> V;
+    std::size_t const w = V::width;
+
+    if ( !NeedLo && !NeedHi )
+    {
+        if ( first != out )
+            std::copy( first, first + n, out );
+        return;
+    }
+
+    if ( n < w )
+    {
+        for ( std::size_t i = 0; i < n; ++i )
+            out[i] = clamp_const( first[i], lo, hi, std::integral_constant<bool, NeedLo>(), std::integral_constant<bool, NeedHi>() );
+        return;
+    }
+
+    auto const vlo = V::set1( lo );
+    auto const vhi = V::set1( hi );
+
+    // clamp() is idempotent, so the tail may overlap already clamped elements:
+    for ( std::size_t i = 0; i < n; )
+    {
+        i = std::min( i, n - w );
+
+        auto v = V::loadu( first + i );
+
+        if ( NeedLo ) v = V::max( vlo, v );
+        if ( NeedHi ) v = V::min( vhi, v );
+
+        V::storeu( out + i, v );
+        i += w;
+    }
+}
+
+} // namespace simd
+
+// generic clamp_range() to compile-time bounds:
+
+template<class Lo, class Hi, class InputIterator, class OutputIterator>
+OutputIterator clamp_range_const( InputIterator first, InputIterator last, OutputIterator out, std::false_type )
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    return std::transform( first, last, out, []( T const& val ) { return ::clamp<Lo, Hi>( val ); } );
+}
+
+// SIMD clamp_range() to compile-time bounds:
+
+template<class Lo, class Hi, class InputIterator, class OutputIterator>
+OutputIterator clamp_range_const( InputIterator first, InputIterator last, OutputIterator out, std::true_type )
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+    typedef const_bounds<Lo, Hi, T> bounds;
+
+    auto const n = std::distance( first, last );
+
+    if ( n <= 0 )
+        return out;
+
+    simd::clamp_n_const<bounds::need_lo::value, bounds::need_hi::value>( std::addressof( *first ),
+        static_cast<std::size_t>( n ), std::addressof( *out ), bounds::lo::value(), bounds::hi::value() );
+
+    return out + n;
+}
+
+} // namespace clamp_detail
+
+// clamp value to compile-time bounds:
+
+template<std::intmax_t Lo, std::intmax_t Hi, class T>
+constexpr T clamp( T const& val )
+{
+    return clamp< std::integral_constant<std::intmax_t, Lo>, std::integral_constant<std::intmax_t, Hi> >( val );
+}
+
+template<class Lo, class Hi, class T>
+constexpr T clamp( T const& val )
+{
+    typedef clamp_detail::const_bounds<Lo, Hi, T> bounds;
+
+    static_assert( bounds::lo::exact() && bounds::hi::exact(), "clamp<Lo, Hi>: expect bounds representable in T" );
+    static_assert( !( bounds::hi::value() < bounds::lo::value() ), "clamp<Lo, Hi>: expect Lo <= Hi" );
+
+    return clamp_detail::clamp_const( val, bounds::lo::value(), bounds::hi::value(),
+        typename bounds::need_lo(), typename bounds::need_hi() );
+}
+
+// clamp range of values to compile-time bounds:
+
+template<std::intmax_t Lo, std::intmax_t Hi, class InputIterator, class OutputIterator>
+OutputIterator clamp_range( InputIterator first, InputIterator last, OutputIterator out )
+{
+    return clamp_range< std::integral_constant<std::intmax_t, Lo>, std::integral_constant<std::intmax_t, Hi> >( first, last, out );
+}
+
+template<class Lo, class Hi, class InputIterator, class OutputIterator>
+OutputIterator clamp_range( InputIterator first, InputIterator last, OutputIterator out )
+{
+    typedef clamp_detail::const_bounds<Lo, Hi, typename std::iterator_traits<InputIterator>::value_type> bounds;
+
+    static_assert( bounds::lo::exact() && bounds::hi::exact(), "clamp_range<Lo, Hi>: expect bounds representable in T" );
+    static_assert( !( bounds::hi::value() < bounds::lo::value() ), "clamp_range<Lo, Hi>: expect Lo <= Hi" );
+
+    return clamp_detail::clamp_range_const<Lo, Hi>( first, last, out,
+        clamp_detail::use_simd<InputIterator, OutputIterator, std14::less<>>() );
+}
+
+// Implementation of clamp_iterator and clamp_view:
+
+template<class Iterator, class Compare>
+class clamp_iterator
+{
+public:
+    typedef typename std::iterator_traits<Iterator>::iterator_category iterator_category;
+    typedef typename std::iterator_traits<Iterator>::iterator_category iterator_concept;
+    typedef typename std::iterator_traits<Iterator>::value_type        value_type;
+    typedef typename std::iterator_traits<Iterator>::difference_type   difference_type;
+    typedef void       pointer;
+    typedef value_type reference;
+
+    clamp_iterator()
+    : it(), lo(), hi(), comp() {}
+
+    clamp_iterator( Iterator it, value_type const& lo, value_type const& hi, Compare comp = Compare() )
+    : it( it ), lo( lo ), hi( hi ), comp( comp ) {}
+
+    Iterator base() const { return it; }
+
+    reference operator*() const { return clamp_value( *it, lo, hi, comp ); }
+    reference operator[]( difference_type n ) const { return clamp_value( it[n], lo, hi, comp ); }
+
+    clamp_iterator & operator++() { ++it; return *this; }
+    clamp_iterator & operator--() { --it; return *this; }
+    clamp_iterator   operator++( int ) { clamp_iterator tmp( *this ); ++it; return tmp; }
+    clamp_iterator   operator--( int ) { clamp_iterator tmp( *this ); --it; return tmp; }
+
+    clamp_iterator & operator+=( difference_type n ) { it += n; return *this; }
+    clamp_iterator & operator-=( difference_type n ) { it -= n; return *this; }
+
+    friend clamp_iterator operator+( clamp_iterator x, difference_type n ) { return x += n; }
+    friend clamp_iterator operator+( difference_type n, clamp_iterator x ) { return x += n; }
+    friend clamp_iterator operator-( clamp_iterator x, difference_type n ) { return x -= n; }
+
+    friend difference_type operator-( clamp_iterator const& x, clamp_iterator const& y ) { return x.it - y.it; }
+
+    friend bool operator==( clamp_iterator const& x, clamp_iterator const& y ) { return x.it == y.it; }
+    friend bool operator!=( clamp_iterator const& x, clamp_iterator const& y ) { return x.it != y.it; }
+    friend bool operator< ( clamp_iterator const& x, clamp_iterator const& y ) { return x.it <  y.it; }
+    friend bool operator> ( clamp_iterator const& x, clamp_iterator const& y ) { return x.it >  y.it; }
+    friend bool operator<=( clamp_iterator const& x, clamp_iterator const& y ) { return x.it <= y.it; }
+    friend bool operator>=( clamp_iterator const& x, clamp_iterator const& y ) { return x.it >= y.it; }
+
+private:
+    Iterator it;
+    value_type lo;
+    value_type hi;
+    Compare comp;
+};
+
+template<class Iterator, class Compare>
+class clamp_view
+{
+public:
+    typedef clamp_iterator<Iterator, Compare> iterator;
+    typedef iterator const_iterator;
+    typedef typename iterator::value_type      value_type;
+    typedef typename iterator::difference_type difference_type;
+
+    clamp_view( Iterator first, Iterator last, value_type const& lo, value_type const& hi, Compare comp )
+    : first( first, lo, hi, comp ), last( last, lo, hi, comp )
+    {
+        assert( !comp(hi, lo) );
+    }
+
+    iterator begin() const { return first; }
+    iterator end()   const { return last;  }
+
+    bool empty() const { return first == last; }
+
+    std::size_t size() const { return static_cast<std::size_t>( std::distance( first.base(), last.base() ) ); }
+
+    value_type operator[]( difference_type n ) const { return first[n]; }
+
+private:
+    iterator first;
+    iterator last;
+};
+
+// view of range of clamped values:
+
+template<class Range, class Compare>
+clamp_view<decltype( std::begin( std::declval<Range&>() ) ), Compare>
+clamped_view( Range& range,
+    typename std::iterator_traits<decltype( std::begin( std::declval<Range&>() ) )>::value_type const& lo,
+    typename std::iterator_traits<decltype( std::begin( std::declval<Range&>() ) )>::value_type const& hi, Compare comp )
+{
+    return { std::begin( range ), std::end( range ), lo, hi, comp };
+}
+
+template<class Iterator, class Compare>
+clamp_view<Iterator, Compare>
+clamped_view( Iterator first, Iterator last,
+    typename std::iterator_traits<Iterator>::value_type const& lo,
+    typename std::iterator_traits<Iterator>::value_type const& hi, Compare comp )
+{
+    return { first, last, lo, hi, comp };
+}
+
+// Implementation of clamp_output_iterator and clamp_copy():
+
+template<class OutputIterator, class T, class Compare>
+class clamp_output_iterator
+{
+public:
+    typedef std::output_iterator_tag iterator_category;
+    typedef void value_type;
+    typedef void difference_type;
+    typedef void pointer;
+    typedef void reference;
+
+    clamp_output_iterator( OutputIterator out, T const& lo, T const& hi, Compare comp = Compare() )
+    : out( out ), lo( lo ), hi( hi ), comp( comp )
+    {
+        assert( !comp(hi, lo) );
+    }
+
+    OutputIterator base() const { return out; }
+
+    clamp_output_iterator & operator=( T const& val )
+    {
+        *out = clamp_value( val, lo, hi, comp );
+        ++out;
+        return *this;
+    }
+
+    clamp_output_iterator & operator*()     { return *this; }
+    clamp_output_iterator & operator++()    { return *this; }
+    clamp_output_iterator & operator++(int) { return *this; }
+
+    // clamp and write range of values:
+
+    template<class InputIterator>
+    clamp_output_iterator write( InputIterator first, InputIterator last ) const
+    {
+        return write( first, last, clamp_detail::lazy_and<
+            std::is_same<typename std::iterator_traits<InputIterator>::value_type, T>::value,
+            clamp_detail::use_simd<InputIterator, OutputIterator, Compare> >() );
+    }
+
+private:
+    template<class InputIterator>
+    clamp_output_iterator write( InputIterator first, InputIterator last, std::false_type ) const
+    {
+        return std::copy( first, last, *this );
+    }
+
+    template<class InputIterator>
+    clamp_output_iterator write( InputIterator first, InputIterator last, std::true_type ) const
+    {
+        return clamp_output_iterator( ::clamp_range( first, last, out, lo, hi, comp ), lo, hi, comp );
+    }
+
+    OutputIterator out;
+    T lo;
+    T hi;
+    Compare comp;
+};
+
+template<class OutputIterator, class T, class Compare>
+clamp_output_iterator<OutputIterator, T, Compare>
+make_clamp_output_iterator( OutputIterator out, T const& lo, T const& hi, Compare comp )
+{
+    return { out, lo, hi, comp };
+}
+
+template<class InputIterator, class OutputIterator>
+OutputIterator clamp_copy( InputIterator first, InputIterator last, OutputIterator out )
+{
+    return std::copy( first, last, out );
+}
+
+template<class InputIterator, class OutputIterator, class T, class Compare>
+clamp_output_iterator<OutputIterator, T, Compare>
+clamp_copy( InputIterator first, InputIterator last, clamp_output_iterator<OutputIterator, T, Compare> out )
+{
+    return out.write( first, last );
+}
+
+// Implementation details of the NaN policies:
+
+namespace clamp_detail {
+
+template<class T>
+constexpr bool is_nan( T const& ) { return false; }
+
+constexpr bool is_nan( float       v ) { return v != v; }
+constexpr bool is_nan( double      v ) { return v != v; }
+constexpr bool is_nan( long double v ) { return v != v; }
+
+inline bool is_nan( clamp_half     v ) { return ( v.bits & 0x7fff ) > 0x7c00; }
+inline bool is_nan( clamp_bfloat16 v ) { return ( v.bits & 0x7fff ) > 0x7f80; }
+
+// types that have NaN values:
+
+template<class T>
+struct has_nan : std::integral_constant<bool, std::is_floating_point<T>::value ||
+    std::is_same<T, clamp_half>::value || std::is_same<T, clamp_bfloat16>::value > {};
+
+// scalar clamp per policy:
+
+template<class T, class Compare>
+constexpr const T& clamp_with( clamp_nan::propagate_policy, const T& val, const T& lo, const T& hi, Compare comp )
+{
+    return ::clamp( val, lo, hi, comp );
+}
+
+template<class T, class Compare>
+constexpr const T& clamp_with( clamp_nan::assume_none_policy, const T& val, const T& lo, const T& hi, Compare comp )
+{
+    return ::clamp( val, lo, hi, comp );
+}
+
+template<class T, class Compare>
+constexpr const T& clamp_with( clamp_nan::to_lo_policy, const T& val, const T& lo, const T& hi, Compare comp )
+{
+    return is_nan( val ) ? lo : ::clamp( val, lo, hi, comp );
+}
+
+template<class T, class Compare>
+constexpr const T& clamp_with( clamp_nan::to_hi_policy, const T& val, const T& lo, const T& hi, Compare comp )
+{
+    return is_nan( val ) ? hi : ::clamp( val, lo, hi, comp );
+}
+
+// the value that replaces NaN:
+
+template<class T> T const& nan_fill( clamp_nan::to_lo_policy, T const& lo, T const&    ) { return lo; }
+template<class T> T const& nan_fill( clamp_nan::to_hi_policy, T const&   , T const& hi ) { return hi; }
+
+namespace simd {
+
+// clamp n contiguous elements to [lo, hi] with std::less<>, replacing NaN
+// with fill:
+
+template<class T>
+void clamp_n_fill( T const * first, std::size_t n, T * out, T const lo, T const hi, T const fill )
+{
+    typedef ops<T> V;
+    std::size_t const w = V::width;
+
+    auto const vlo   = V::set1( lo );
+    auto const vhi   = V::set1( hi );
+    auto const vfill = V::set1( fill );
+
+    std::size_t i = 0;
+    for ( ; i + w <= n; i += w )
+    {
+        auto const v = V::loadu( first + i );
+        V::storeu( out + i, V::if_nan( v, vfill, V::min( vhi, V::max( vlo, v ) ) ) );
+    }
+
+    for ( ; i < n; ++i )
+        out[i] = is_nan( first[i] ) ? fill : clamp_value( first[i], lo, hi );
+}
+
+} // namespace simd
+
+// generic clamp_range() per NaN policy:
+
+template<class NanPolicy, class InputIterator, class OutputIterator, class T, class Compare>
+OutputIterator clamp_range( NanPolicy policy,
+    InputIterator first, InputIterator last, OutputIterator out,
+    T const& lo, T const& hi, Compare comp, std::false_type )
+{
+    for ( ; first != last; ++first, ++out )
+    {
+        T const& val = *first;
+        *out = is_nan( val ) ? nan_fill( policy, lo, hi ) : clamp_fast<T>( val, lo, hi, comp, std::is_arithmetic<T>() );
+    }
+    return out;
+}
+
+// SIMD clamp_range() per NaN policy, clamping to [hi, lo] for greater is
+// equivalent:
+
+template<class NanPolicy, class InputIterator, class OutputIterator, class T, class Compare>
+OutputIterator clamp_range( NanPolicy policy,
+    InputIterator first, InputIterator last, OutputIterator out,
+    T const& lo, T const& hi, Compare comp, std::true_type )
+{
+    assert( !comp(hi, lo) ); (void) comp;
+
+    auto const n = std::distance( first, last );
+
+    if ( n <= 0 )
+        return out;
+
+    auto const src = std::addressof( *first );
+    auto const dst = std::addressof( *out );
+
+    if ( is_greater<Compare, T>::value )
+        simd::clamp_n_fill<T>( src, static_cast<std::size_t>( n ), dst, hi, lo, nan_fill( policy, lo, hi ) );
+    else
+        simd::clamp_n_fill<T>( src, static_cast<std::size_t>( n ), dst, lo, hi, nan_fill( policy, lo, hi ) );
+
+    return out + n;
+}
+
+// NaN is propagated by, or of no concern to, the plain clamp_range(), and
+// only types with NaN values need replacing it:
+
+template<class InputIterator, class OutputIterator, class T, class Compare>
+OutputIterator clamp_range( clamp_nan::propagate_policy,
+    InputIterator first, InputIterator last, OutputIterator out, T const& lo, T const& hi, Compare comp )
+{
+    return ::clamp_range( first, last, out, lo, hi, comp );
+}
+
+template<class InputIterator, class OutputIterator, class T, class Compare>
+OutputIterator clamp_range( clamp_nan::assume_none_policy,
+    InputIterator first, InputIterator last, OutputIterator out, T const& lo, T const& hi, Compare comp )
+{
+    return ::clamp_range( first, last, out, lo, hi, comp );
+}
+
+template<class NanPolicy, class InputIterator, class OutputIterator, class T, class Compare>
+OutputIterator clamp_range_fill( NanPolicy,
+    InputIterator first, InputIterator last, OutputIterator out, T const& lo, T const& hi, Compare comp, std::false_type )
+{
+    return ::clamp_range( first, last, out, lo, hi, comp );
+}
+
+template<class NanPolicy, class InputIterator, class OutputIterator, class T, class Compare>
+OutputIterator clamp_range_fill( NanPolicy policy,
+    InputIterator first, InputIterator last, OutputIterator out, T const& lo, T const& hi, Compare comp, std::true_type )
+{
+    return clamp_range( policy, first, last, out, lo, hi, comp, use_simd<InputIterator, OutputIterator, Compare>() );
+}
+
+template<class NanPolicy, class InputIterator, class OutputIterator, class T, class Compare>
+OutputIterator clamp_range( NanPolicy policy,
+    InputIterator first, InputIterator last, OutputIterator out, T const& lo, T const& hi, Compare comp )
+{
+    return clamp_range_fill( policy, first, last, out, lo, hi, comp, has_nan<T>() );
+}
+
+} // namespace clamp_detail
+
+// clamp value per NaN policy:
+
+template<class NanPolicy, class T, class Compare>
+constexpr typename clamp_nan::enable_if_policy<NanPolicy, const T&>::type
+clamp( NanPolicy policy, const T& val, const T& lo, const T& hi, Compare comp )
+{
+    return clamp_detail::clamp_with( policy, val, lo, hi, comp );
+}
+
+// clamp range of values per NaN policy:
+
+template<class NanPolicy, class InputIterator, class OutputIterator, class Compare>
+typename clamp_nan::enable_if_policy<NanPolicy, OutputIterator>::type
+clamp_range( NanPolicy policy, InputIterator first, InputIterator last, OutputIterator out,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp )
+{
+    return clamp_detail::clamp_range( policy, first, last, out, lo, hi, comp );
+}
+
+// Implementation details of clamp_range_batch():
+
+namespace clamp_detail {
+
+// clamp ranges [first, last) of the batch; each range uses clamp_range() and
+// its SIMD kernel with an overlapping tail, or its scalar loop for ranges
+// shorter than a vector:
+
+template<class ForwardIterator, class Compare>
+void clamp_batch( ForwardIterator first, ForwardIterator last, Compare comp )
+{
+    for ( ; first != last; ++first )
+        ::clamp_range( first->first, first->last, first->out, first->lo, first->hi, comp );
+}
+
+// clamp blocks of consecutive ranges of at least half the threshold elements
+// in total, about four blocks per thread:
+
+template<class ForwardIterator, class Compare>
+void parallel_clamp_batch( ForwardIterator first, ForwardIterator last, Compare comp, std::true_type )
+{
+    std::size_t const count = static_cast<std::size_t>( std::distance( first, last ) );
+
+    std::size_t n = 0;
+    for ( ForwardIterator it = first; it != last; ++it )
+        n += static_cast<std::size_t>( it->last - it->first );
+
+    if ( n < std::size_t( CLAMP_PARALLEL_THRESHOLD ) || count < 2 || thread_pool::instance().size() == 0 )
+        return clamp_batch( first, last, comp );
+
+    std::size_t const max_blocks = 4 * ( thread_pool::instance().size() + 1 );
+    std::size_t const blocks     = std::min( max_blocks, n / ( std::size_t( CLAMP_PARALLEL_THRESHOLD ) / 2 ) );
+
+    // split where the running element count passes the next multiple of n / blocks:
+    std::vector<std::size_t> split( 1, 0 );
+    std::size_t sum = 0;
+
+    for ( std::size_t k = 0; k + 1 < count; ++k )
+    {
+        sum += static_cast<std::size_t>( first[k].last - first[k].first );
+
+        if ( sum * blocks >= n * split.size() )
+            split.push_back( k + 1 );
+    }
+    split.push_back( count );
+
+    parallel_for( split.size() - 1, [=, &split]( std::size_t i )
+    {
+        clamp_batch( first + split[i], first + split[i + 1], comp );
+    });
+}
+
+template<class ForwardIterator, class Compare>
+void parallel_clamp_batch( ForwardIterator first, ForwardIterator last, Compare comp, std::false_type )
+{
+    clamp_batch( first, last, comp );
+}
+
+template<class ForwardIterator, class Compare>
+void clamp_range_batch( clamp_execution::sequenced_policy, ForwardIterator first, ForwardIterator last, Compare comp )
+{
+    clamp_batch( first, last, comp );
+}
+
+template<class ForwardIterator, class Compare>
+void clamp_range_batch( clamp_execution::parallel_policy, ForwardIterator first, ForwardIterator last, Compare comp )
+{
+    parallel_clamp_batch( first, last, comp, is_random_access<ForwardIterator>() );
+}
+
+template<class ForwardIterator, class Compare>
+void clamp_range_batch( clamp_execution::parallel_unsequenced_policy, ForwardIterator first, ForwardIterator last, Compare comp )
+{
+    parallel_clamp_batch( first, last, comp, is_random_access<ForwardIterator>() );
+}
+
+} // namespace clamp_detail
+
+// clamp batch of ranges:
+
+template<class ForwardIterator, class Compare>
+void clamp_range_batch( ForwardIterator first, ForwardIterator last, Compare comp )
+{
+    clamp_detail::clamp_batch( first, last, comp );
+}
+
+// clamp batch of ranges per execution policy:
+
+template<class ExecutionPolicy, class ForwardIterator, class Compare>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, void>::type
+clamp_range_batch( ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, Compare comp )
+{
+    clamp_detail::clamp_range_batch( typename std::decay<ExecutionPolicy>::type( policy ), first, last, comp );
+}
+
+// Implementation details of clamp_indexed(), clamp_gather() and clamp_scatter():
+
+namespace clamp_detail {
+namespace simd {
+
+// Per element size and index size: width, gather(), which loads the elements
+// at base[idx[0..width)] into an integer register, and with AVX-512 also
+// scatter(), which stores them, in index order so that of equal indices the
+// last one wins. 4-byte indices are sign extended, so they must be signed.
+// A width of 0 means: no gather support for these sizes.
+
+template<std::size_t Size, std::size_t IndexSize>
+struct indexed_of { enum { width = 0, has_scatter = 0 }; };
+
+#if CLAMP_HAVE_AVX512F
+
+template<> struct indexed_of<4, 4>
+{
+    enum { width = 16, has_scatter = 1 };
+    static __m512i gather( void const * base, void const * idx ) { return _mm512_i32gather_epi32( _mm512_loadu_si512( idx ), base, 4 ); }
+    static void scatter( void * base, void const * idx, __m512i v ) { _mm512_i32scatter_epi32( base, _mm512_loadu_si512( idx ), v, 4 ); }
+};
+
+template<> struct indexed_of<4, 8>
+{
+    enum { width = 16, has_scatter = 1 };
+    static __m512i gather( void const * base, void const * idx )
+    {
+        __m256i const a = _mm512_i64gather_epi32( _mm512_loadu_si512( idx ), base, 4 );
+        __m256i const b = _mm512_i64gather_epi32( _mm512_loadu_si512( static_cast<char const *>( idx ) + 64 ), base, 4 );
+        return _mm512_inserti64x4( _mm512_castsi256_si512( a ), b, 1 );
+    }
+    static void scatter( void * base, void const * idx, __m512i v )
+    {
+        _mm512_i64scatter_epi32( base, _mm512_loadu_si512( idx ), _mm512_castsi512_si256( v ), 4 );
+        _mm512_i64scatter_epi32( base, _mm512_loadu_si512( static_cast<char const *>( idx ) + 64 ), _mm512_extracti64x4_epi64( v, 1 ), 4 );
+    }
+};
+
+template<> struct indexed_of<8, 4>
+{
+    enum { width = 8, has_scatter = 1 };
+    static __m512i gather( void const * base, void const * idx ) { return _mm512_i32gather_epi64( _mm256_loadu_si256( static_cast<__m256i const *>( idx ) ), base, 8 ); }
+    static void scatter( void * base, void const * idx, __m512i v ) { _mm512_i32scatter_epi64( base, _mm256_loadu_si256( static_cast<__m256i const *>( idx ) ), v, 8 ); }
+};
+
+template<> struct indexed_of<8, 8>
+{
+    enum { width = 8, has_scatter = 1 };
+    static __m512i gather( void const * base, void const * idx ) { return _mm512_i64gather_epi64( _mm512_loadu_si512( idx ), base, 8 ); }
+    static void scatter( void * base, void const * idx, __m512i v ) { _mm512_i64scatter_epi64( base, _mm512_loadu_si512( idx ), v, 8 ); }
+};
+
+inline __m512i from_bits( __m512i v, __m512i ) { return v; }
+inline __m512  from_bits( __m512i v, __m512  ) { return _mm512_castsi512_ps( v ); }
+inline __m512d from_bits( __m512i v, __m512d ) { return _mm512_castsi512_pd( v ); }
+
+inline __m512i to_bits( __m512i v ) { return v; }
+inline __m512i to_bits( __m512  v ) { return _mm512_castps_si512( v ); }
+inline __m512i to_bits( __m512d v ) { return _mm512_castpd_si512( v ); }
+
+#elif CLAMP_HAVE_AVX2
+
+template<> struct indexed_of<4, 4>
+{
+    enum { width = 8, has_scatter = 0 };
+    static __m256i gather( void const * base, void const * idx ) { return _mm256_i32gather_epi32( static_cast<int const *>( base ), _mm256_loadu_si256( static_cast<__m256i const *>( idx ) ), 4 ); }
+};
+
+template<> struct indexed_of<4, 8>
+{
+    enum { width = 8, has_scatter = 0 };
+    static __m256i gather( void const * base, void const * idx )
+    {
+        __m256i const * const i = static_cast<__m256i const *>( idx );
+        __m128i const a = _mm256_i64gather_epi32( static_cast<int const *>( base ), _mm256_loadu_si256( i ), 4 );
+        __m128i const b = _mm256_i64gather_epi32( static_cast<int const *>( base ), _mm256_loadu_si256( i + 1 ), 4 );
+        return _mm256_inserti128_si256( _mm256_castsi128_si256( a ), b, 1 );
+    }
+};
+
+template<> struct indexed_of<8, 4>
+{
+    enum { width = 4, has_scatter = 0 };
+    static __m256i gather( void const * base, void const * idx ) { return _mm256_i32gather_epi64( static_cast<long long const *>( base ), _mm_loadu_si128( static_cast<__m128i const *>( idx ) ), 8 ); }
+};
+
+template<> struct indexed_of<8, 8>
+{
+    enum { width = 4, has_scatter = 0 };
+    static __m256i gather( void const * base, void const * idx ) { return _mm256_i64gather_epi64( static_cast<long long const *>( base ), _mm256_loadu_si256( static_cast<__m256i const *>( idx ) ), 8 ); }
+};
+
+inline __m256i from_bits( __m256i v, __m256i ) { return v; }
+inline __m256  from_bits( __m256i v, __m256  ) { return _mm256_castsi256_ps( v ); }
+inline __m256d from_bits( __m256i v, __m256d ) { return _mm256_castsi256_pd( v ); }
+
+#endif
+
+template<class T, class Index>
+struct indexed : indexed_of< sizeof(T), sizeof(Index) > {};
+
+// clamp base[idx[k]] to out[k], for k in [0, n), to [lo, hi] with std::less<>:
+
+template<class T, class Index>
+void clamp_gather_n( T const * base, Index const * idx, std::size_t n, T * out, T const lo, T const hi )
+{
+    typedef ops<T> V;
+    typedef indexed<T, Index> I;
+    typedef typename V::reg reg;
+    std::size_t const w = V::width;
+
+    auto const vlo = V::set1( lo );
+    auto const vhi = V::set1( hi );
+
+    std::size_t k = 0;
+    for ( ; k + w <= n; k += w )
+    {
+        V::storeu( out + k, V::min( vhi, V::max( vlo, from_bits( I::gather( base, idx + k ), reg() ) ) ) );
+    }
+
+    for ( ; k < n; ++k )
+        out[k] = clamp_value( base[ idx[k] ], lo, hi );
+}
+
+// clamp in[k] to base[idx[k]], for k in [0, n), to [lo, hi] with std::less<>;
+// for in place, in is 0 and the values are gathered from base:
+
+#if CLAMP_HAVE_AVX512F
+
+template<class T, class Index>
+void clamp_scatter_n( T const * in, Index const * idx, std::size_t n, T * base, T const lo, T const hi )
+{
+    typedef ops<T> V;
+    typedef indexed<T, Index> I;
+    typedef typename V::reg reg;
+    std::size_t const w = V::width;
+
+    auto const vlo = V::set1( lo );
+    auto const vhi = V::set1( hi );
+
+    std::size_t k = 0;
+    for ( ; k + w <= n; k += w )
+    {
+        reg const v = in ? V::loadu( in + k ) : from_bits( I::gather( base, idx + k ), reg() );
+        I::scatter( base, idx + k, to_bits( V::min( vhi, V::max( vlo, v ) ) ) );
+    }
+
+    for ( ; k < n; ++k )
+        base[ idx[k] ] = clamp_value( in ? in[k] : base[ idx[k] ], lo, hi );
+}
+
+#else
+
+template<class T, class Index>
+void clamp_scatter_n( T const * in, Index const * idx, std::size_t n, T * base, T const lo, T const hi )
+{
+    for ( std::size_t k = 0; k < n; ++k )
+        base[ idx[k] ] = clamp_value( in ? in[k] : base[ idx[k] ], lo, hi );
+}
+
+#endif // CLAMP_HAVE_AVX512F
+
+} // namespace simd
+
+// use gather (and scatter) for contiguous 4 and 8-byte arithmetic data with
+// contiguous integer indices, compared with less or greater:
+
+template<class DataIterator, class IndexIterator, class Compare, bool Scatter,
+         class T = typename std::iterator_traits<DataIterator>::value_type,
+         class Index = typename std::iterator_traits<IndexIterator>::value_type>
+struct use_simd_indexed : lazy_and< simd::has<T>::value && simd::indexed<T, Index>::width == simd::ops<T>::width, std::integral_constant<bool,
+    ( !Scatter || simd::indexed<T, Index>::has_scatter ) &&
+    std::is_integral<Index>::value && ( sizeof(Index) == 8 || std::is_signed<Index>::value ) &&
+    is_contiguous_input<DataIterator, T>::value &&
+    is_contiguous_input<IndexIterator, Index>::value &&
+    ( is_less<Compare, T>::value || is_greater<Compare, T>::value ) > > {};
+
+template<class Compare, class T>
+T const & simd_lo( T const & lo, T const & hi ) { return is_greater<Compare, T>::value ? hi : lo; }
+
+template<class Compare, class T>
+T const & simd_hi( T const & lo, T const & hi ) { return is_greater<Compare, T>::value ? lo : hi; }
+
+// generic and SIMD clamp_indexed():
+
+template<class RandomAccessIterator, class IndexIterator, class T, class Compare>
+void clamp_indexed( RandomAccessIterator first, IndexIterator index_first, IndexIterator index_last,
+    T const& lo, T const& hi, Compare comp, std::false_type )
+{
+    for ( ; index_first != index_last; ++index_first )
+    {
+        auto && x = first[ *index_first ];
+        x = clamp_fast<T>( x, lo, hi, comp, std::is_arithmetic<T>() );
+    }
+}
+
+template<class RandomAccessIterator, class IndexIterator, class T, class Compare>
+void clamp_indexed( RandomAccessIterator first, IndexIterator index_first, IndexIterator index_last,
+    T const& lo, T const& hi, Compare comp, std::true_type )
+{
+    assert( !comp(hi, lo) ); (void) comp;
+
+    if ( index_first == index_last )
+        return;
+
+    simd::clamp_scatter_n<T>( static_cast<T const *>( nullptr ), std::addressof( *index_first ),
+        static_cast<std::size_t>( index_last - index_first ), std::addressof( *first ), simd_lo<Compare>( lo, hi ), simd_hi<Compare>( lo, hi ) );
+}
+
+// generic and SIMD clamp_gather():
+
+template<class RandomAccessIterator, class IndexIterator, class OutputIterator, class T, class Compare>
+OutputIterator clamp_gather( RandomAccessIterator first, IndexIterator index_first, IndexIterator index_last, OutputIterator out,
+    T const& lo, T const& hi, Compare comp, std::false_type )
+{
+    for ( ; index_first != index_last; ++index_first, ++out )
+        *out = clamp_fast<T>( first[ *index_first ], lo, hi, comp, std::is_arithmetic<T>() );
+
+    return out;
+}
+
+template<class RandomAccessIterator, class IndexIterator, class OutputIterator, class T, class Compare>
+OutputIterator clamp_gather( RandomAccessIterator first, IndexIterator index_first, IndexIterator index_last, OutputIterator out,
+    T const& lo, T const& hi, Compare comp, std::true_type )
+{
+    assert( !comp(hi, lo) ); (void) comp;
+
+    auto const n = index_last - index_first;
+
+    if ( n <= 0 )
+        return out;
+
+    simd::clamp_gather_n<T>( std::addressof( *first ), std::addressof( *index_first ),
+        static_cast<std::size_t>( n ), std::addressof( *out ), simd_lo<Compare>( lo, hi ), simd_hi<Compare>( lo, hi ) );
+
+    return out + n;
+}
+
+// generic and SIMD clamp_scatter():
+
+template<class InputIterator, class IndexIterator, class RandomAccessIterator, class T, class Compare>
+void clamp_scatter( InputIterator first, InputIterator last, IndexIterator index_first, RandomAccessIterator out,
+    T const& lo, T const& hi, Compare comp, std::false_type )
+{
+    for ( ; first != last; ++first, ++index_first )
+        out[ *index_first ] = clamp_fast<T>( *first, lo, hi, comp, std::is_arithmetic<T>() );
+}
+
+template<class InputIterator, class IndexIterator, class RandomAccessIterator, class T, class Compare>
+void clamp_scatter( InputIterator first, InputIterator last, IndexIterator index_first, RandomAccessIterator out,
+    T const& lo, T const& hi, Compare comp, std::true_type )
+{
+    assert( !comp(hi, lo) ); (void) comp;
+
+    if ( first == last )
+        return;
+
+    simd::clamp_scatter_n<T>( std::addressof( *first ), std::addressof( *index_first ),
+        static_cast<std::size_t>( last - first ), std::addressof( *out ), simd_lo<Compare>( lo, hi ), simd_hi<Compare>( lo, hi ) );
+}
+
+template<class InputIterator, class IndexIterator, class RandomAccessIterator, class Compare>
+struct use_simd_scatter : lazy_and<
+    is_contiguous_input<InputIterator, typename std::iterator_traits<RandomAccessIterator>::value_type>::value,
+    use_simd_indexed<RandomAccessIterator, IndexIterator, Compare, true> > {};
+
+template<class RandomAccessIterator, class IndexIterator, class OutputIterator, class Compare>
+struct use_simd_gather : lazy_and<
+    is_contiguous_output<OutputIterator, typename std::iterator_traits<RandomAccessIterator>::value_type>::value,
+    use_simd_indexed<RandomAccessIterator, IndexIterator, Compare, false> > {};
+
+// call f(pos, len) for chunks of [0, n) of at least half the threshold, about
+// four chunks per thread, on the thread pool:
+
+template<class F>
+void parallel_chunks( std::size_t n, F f )
+{
+    if ( n < std::size_t( CLAMP_PARALLEL_THRESHOLD ) || thread_pool::instance().size() == 0 )
+        return f( std::size_t( 0 ), n );
+
+    std::size_t const min_chunk = std::size_t( CLAMP_PARALLEL_THRESHOLD ) / 2;
+    std::size_t const max_count = 4 * ( thread_pool::instance().size() + 1 );
+    std::size_t const count     = std::min( max_count, n / min_chunk );
+    std::size_t const chunk     = ( ( n + count - 1 ) / count + 63 ) / 64 * 64;
+
+    parallel_for( ( n + chunk - 1 ) / chunk, [=]( std::size_t i )
+    {
+        f( i * chunk, std::min( chunk, n - i * chunk ) );
+    });
+}
+
+template<class RandomAccessIterator, class IndexIterator, class T, class Compare>
+void parallel_clamp_indexed( RandomAccessIterator first, IndexIterator index_first, IndexIterator index_last,
+    T const& lo, T const& hi, Compare comp, std::true_type )
+{
+    parallel_chunks( static_cast<std::size_t>( index_last - index_first ), [=]( std::size_t pos, std::size_t len )
+    {
+        ::clamp_indexed( first, index_first + pos, index_first + pos + len, lo, hi, comp );
+    });
+}
+
+template<class RandomAccessIterator, class IndexIterator, class T, class Compare>
+void parallel_clamp_indexed( RandomAccessIterator first, IndexIterator index_first, IndexIterator index_last,
+    T const& lo, T const& hi, Compare comp, std::false_type )
+{
+    ::clamp_indexed( first, index_first, index_last, lo, hi, comp );
+}
+
+template<class RandomAccessIterator, class IndexIterator, class OutputIterator, class T, class Compare>
+OutputIterator parallel_clamp_gather( RandomAccessIterator first, IndexIterator index_first, IndexIterator index_last, OutputIterator out,
+    T const& lo, T const& hi, Compare comp, std::true_type )
+{
+    std::size_t const n = static_cast<std::size_t>( index_last - index_first );
+
+    parallel_chunks( n, [=]( std::size_t pos, std::size_t len )
+    {
+        ::clamp_gather( first, index_first + pos, index_first + pos + len, out + pos, lo, hi, comp );
+    });
+
+    return out + n;
+}
+
+template<class RandomAccessIterator, class IndexIterator, class OutputIterator, class T, class Compare>
+OutputIterator parallel_clamp_gather( RandomAccessIterator first, IndexIterator index_first, IndexIterator index_last, OutputIterator out,
+    T const& lo, T const& hi, Compare comp, std::false_type )
+{
+    return ::clamp_gather( first, index_first, index_last, out, lo, hi, comp );
+}
+
+template<class InputIterator, class IndexIterator, class RandomAccessIterator, class T, class Compare>
+void parallel_clamp_scatter( InputIterator first, InputIterator last, IndexIterator index_first, RandomAccessIterator out,
+    T const& lo, T const& hi, Compare comp, std::true_type )
+{
+    parallel_chunks( static_cast<std::size_t>( last - first ), [=]( std::size_t pos, std::size_t len )
+    {
+        ::clamp_scatter( first + pos, first + pos + len, index_first + pos, out, lo, hi, comp );
+    });
+}
+
+template<class InputIterator, class IndexIterator, class RandomAccessIterator, class T, class Compare>
+void parallel_clamp_scatter( InputIterator first, InputIterator last, IndexIterator index_first, RandomAccessIterator out,
+    T const& lo, T const& hi, Compare comp, std::false_type )
+{
+    ::clamp_scatter( first, last, index_first, out, lo, hi, comp );
+}
+
+template<class ExecutionPolicy>
+struct is_parallel : std::integral_constant<bool,
+    !std::is_same<ExecutionPolicy, clamp_execution::sequenced_policy>::value > {};
+
+} // namespace clamp_detail
+
+// clamp values at indices in place:
+
+template<class RandomAccessIterator, class IndexIterator, class Compare>
+void clamp_indexed( RandomAccessIterator first, IndexIterator index_first, IndexIterator index_last,
+    typename std::iterator_traits<RandomAccessIterator>::value_type const& lo,
+    typename std::iterator_traits<RandomAccessIterator>::value_type const& hi, Compare comp )
+{
+    clamp_detail::clamp_indexed( first, index_first, index_last, lo, hi, comp,
+        clamp_detail::use_simd_indexed<RandomAccessIterator, IndexIterator, Compare, true>() );
+}
+
+// gather clamped values at indices:
+
+template<class RandomAccessIterator, class IndexIterator, class OutputIterator, class Compare>
+OutputIterator clamp_gather( RandomAccessIterator first, IndexIterator index_first, IndexIterator index_last, OutputIterator out,
+    typename std::iterator_traits<RandomAccessIterator>::value_type const& lo,
+    typename std::iterator_traits<RandomAccessIterator>::value_type const& hi, Compare comp )
+{
+    return clamp_detail::clamp_gather( first, index_first, index_last, out, lo, hi, comp,
+        clamp_detail::use_simd_gather<RandomAccessIterator, IndexIterator, OutputIterator, Compare>() );
+}
+
+// scatter clamped values to indices:
+
+template<class InputIterator, class IndexIterator, class RandomAccessIterator, class Compare>
+void clamp_scatter( InputIterator first, InputIterator last, IndexIterator index_first, RandomAccessIterator out,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp )
+{
+    clamp_detail::clamp_scatter( first, last, index_first, out, lo, hi, comp,
+        clamp_detail::use_simd_scatter<InputIterator, IndexIterator, RandomAccessIterator, Compare>() );
+}
+
+// indexed clamp, gather and scatter per execution policy:
+
+template<class ExecutionPolicy, class RandomAccessIterator, class IndexIterator, class Compare>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, void>::type
+clamp_indexed( ExecutionPolicy&&, RandomAccessIterator first, IndexIterator index_first, IndexIterator index_last,
+    typename std::iterator_traits<RandomAccessIterator>::value_type const& lo,
+    typename std::iterator_traits<RandomAccessIterator>::value_type const& hi, Compare comp )
+{
+    clamp_detail::parallel_clamp_indexed( first, index_first, index_last, lo, hi, comp, std::integral_constant<bool,
+        clamp_detail::is_parallel<typename std::decay<ExecutionPolicy>::type>::value &&
+        clamp_detail::is_random_access<IndexIterator>::value>() );
+}
+
+template<class ExecutionPolicy, class RandomAccessIterator, class IndexIterator, class OutputIterator, class Compare>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, OutputIterator>::type
+clamp_gather( ExecutionPolicy&&, RandomAccessIterator first, IndexIterator index_first, IndexIterator index_last, OutputIterator out,
+    typename std::iterator_traits<RandomAccessIterator>::value_type const& lo,
+    typename std::iterator_traits<RandomAccessIterator>::value_type const& hi, Compare comp )
+{
+    return clamp_detail::parallel_clamp_gather( first, index_first, index_last, out, lo, hi, comp, std::integral_constant<bool,
+        clamp_detail::is_parallel<typename std::decay<ExecutionPolicy>::type>::value &&
+        clamp_detail::use_parallel<IndexIterator, OutputIterator>::value>() );
+}
+
+template<class ExecutionPolicy, class InputIterator, class IndexIterator, class RandomAccessIterator, class Compare>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, void>::type
+clamp_scatter( ExecutionPolicy&&, InputIterator first, InputIterator last, IndexIterator index_first, RandomAccessIterator out,
+    typename std::iterator_traits<InputIterator>::value_type const& lo,
+    typename std::iterator_traits<InputIterator>::value_type const& hi, Compare comp )
+{
+    clamp_detail::parallel_clamp_scatter( first, last, index_first, out, lo, hi, comp, std::integral_constant<bool,
+        clamp_detail::is_parallel<typename std::decay<ExecutionPolicy>::type>::value &&
+        clamp_detail::use_parallel<InputIterator, IndexIterator>::value>() );
+}
+
+// Implementation details of clamp_sorted_range():
+
+namespace clamp_detail {
+
+// fill below, copy the unchanged values [mid_first, mid_last), fill above;
+// skip the copy if out refers to first:
+
+template<class ForwardIterator, class OutputIterator, class Size, class T>
+OutputIterator fill_copy_fill( ForwardIterator /*first*/, ForwardIterator mid_first, ForwardIterator mid_last, OutputIterator out,
+    Size below, Size above, T const& lo, T const& hi, std::false_type )
+{
+    out = std::fill_n( out, below, lo );
+    out = std::copy( mid_first, mid_last, out );
+    return std::fill_n( out, above, hi );
+}
+
+template<class ForwardIterator, class OutputIterator, class Size, class T>
+OutputIterator fill_copy_fill( ForwardIterator first, ForwardIterator mid_first, ForwardIterator mid_last, OutputIterator out,
+    Size below, Size above, T const& lo, T const& hi, std::true_type )
+{
+    if ( first == mid_last || std::addressof( *first ) != std::addressof( *out ) )
+        return fill_copy_fill( first, mid_first, mid_last, out, below, above, lo, hi, std::false_type() );
+
+    out = std::fill_n( out, below, lo );
+    std::advance( out, std::distance( mid_first, mid_last ) );
+    return std::fill_n( out, above, hi );
+}
+
+} // namespace clamp_detail
+
+// clamp sorted range of values:
+
+template<class ForwardIterator, class OutputIterator, class Compare>
+OutputIterator clamp_sorted_range( ForwardIterator first, ForwardIterator last, OutputIterator out,
+    typename std::iterator_traits<ForwardIterator>::value_type const& lo,
+    typename std::iterator_traits<ForwardIterator>::value_type const& hi, Compare comp )
+{
+    assert( !comp(hi, lo) );
+
+    ForwardIterator const mid_first = std::lower_bound( first, last, lo, comp );
+    ForwardIterator const mid_last  = std::upper_bound( mid_first, last, hi, comp );
+
+    return clamp_detail::fill_copy_fill( first, mid_first, mid_last, out,
+        std::distance( first, mid_first ), std::distance( mid_last, last ), lo, hi,
+        clamp_detail::may_alias<ForwardIterator, OutputIterator>() );
+}
+
+// Implementation details of clamp_range_projected():
+
+namespace clamp_detail {
+
+// proj(t) for a callable and t.*proj for a pointer to data member:
+
+template<class Projection, class T>
+auto invoke_projection( Projection & proj, T && t ) -> decltype( proj( std::forward<T>( t ) ) )
+{
+    return proj( std::forward<T>( t ) );
+}
+
+template<class M, class C, class T>
+auto invoke_projection( M C::* const & pm, T && t ) -> decltype( ( std::forward<T>( t ).*pm ) )
+{
+    return std::forward<T>( t ).*pm;
+}
+
+} // namespace clamp_detail
+
+template<class Iterator, class Projection>
+struct clamp_projected
+{
+    typedef typename std::decay< decltype( clamp_detail::invoke_projection(
+        std::declval<Projection &>(), *std::declval<Iterator &>() ) ) >::type type;
+};
+
+namespace clamp_detail {
+namespace simd {
+
+// Per element size: width and masked load() and store() of an integer
+// register, which do not access the memory of the lanes that are not in the
+// mask. A width of 0 means: no masked loads and stores for this size.
+
+template<std::size_t Size>
+struct masked_of { enum { width = 0 }; };
+
+#if CLAMP_HAVE_AVX512F
+
+template<> struct masked_of<4>
+{
+    enum { width = 16 };
+    typedef __mmask16 mask;
+    static __m512i load( mask k, void const * p ) { return _mm512_maskz_loadu_epi32( k, p ); }
+    static void store( void * p, mask k, __m512i v ) { _mm512_mask_storeu_epi32( p, k, v ); }
+};
+
+template<> struct masked_of<8>
+{
+    enum { width = 8 };
+    typedef __mmask8 mask;
+    static __m512i load( mask k, void const * p ) { return _mm512_maskz_loadu_epi64( k, p ); }
+    static void store( void * p, mask k, __m512i v ) { _mm512_mask_storeu_epi64( p, k, v ); }
+};
+
+// clamp the n elements first[0], first[stride], ... to [lo, hi] with
+// std::less<>; each vector of memory is loaded and stored with the mask of
+// the lanes of these elements, so that the memory in between, such as the
+// other members of records, is left alone:
+
+template<class T>
+void clamp_strided_n( T * first, std::size_t n, std::size_t stride, T const lo, T const hi )
+{
+    typedef ops<T> V;
+    typedef masked_of<sizeof(T)> M;
+    typedef typename V::reg reg;
+    std::size_t const w = V::width;
+
+    // with fewer than about three elements per vector, scalar code is as fast:
+    if ( 8 * stride > 3 * w )
+    {
+        for ( std::size_t i = 0; i < n; ++i )
+            first[ i * stride ] = clamp_value( first[ i * stride ], lo, hi );
+        return;
+    }
+
+    auto const vlo = V::set1( lo );
+    auto const vhi = V::set1( hi );
+
+    std::uint64_t pattern = 0;
+    for ( std::size_t l = 0; l < w; l += stride )
+        pattern |= std::uint64_t( 1 ) << l;
+
+    std::uint64_t const full  = ( std::uint64_t( 1 ) << w ) - 1;
+    std::size_t   const lanes = n ? ( n - 1 ) * stride + 1 : 0;
+    std::size_t   const step  = stride - w % stride;
+
+    // lead: lane of the first element in the vector at lane j:
+    for ( std::size_t j = 0, lead = 0; j < lanes; j += w, lead = lead + step < stride ? lead + step : lead + step - stride )
+    {
+        std::uint64_t k = ( pattern << lead ) & full;
+
+        if ( lanes - j < w )
+            k &= ( std::uint64_t( 1 ) << ( lanes - j ) ) - 1;
+
+        typename M::mask const m = static_cast<typename M::mask>( k );
+
+        reg const v = from_bits( M::load( m, first + j ), reg() );
+        M::store( first + j, m, to_bits( V::min( vhi, V::max( vlo, v ) ) ) );
+    }
+}
+
+#endif // CLAMP_HAVE_AVX512F
+
+} // namespace simd
+
+// use the strided kernel for a pointer to an arithmetic data member of the
+// records of a contiguous range, with a record size that is a multiple of the
+// member size, compared with less or greater:
+
+template<class Iterator, class Projection, class Compare>
+struct use_simd_projected : std::false_type {};
+
+template<class Iterator, class M, class C, class Compare>
+struct use_simd_projected<Iterator, M C::*, Compare> : lazy_and< simd::has<M>::value && simd::masked_of<sizeof(M)>::width == simd::ops<M>::width, std::integral_constant<bool,
+    is_contiguous_output<Iterator, C>::value &&
+    sizeof(C) % sizeof(M) == 0 &&
+    ( is_less<Compare, M>::value || is_greater<Compare, M>::value ) > > {};
+
+// clamp value in place; other than arithmetic values are only assigned when
+// out of range:
+
+template<class T, class Compare>
+void clamp_in_place( T & val, T const& lo, T const& hi, Compare comp, std::true_type /*arithmetic*/ )
+{
+    val = clamp_fast<T>( val, lo, hi, comp, std::true_type() );
+}
+
+template<class T, class Compare>
+void clamp_in_place( T & val, T const& lo, T const& hi, Compare comp, std::false_type /*arithmetic*/ )
+{
+    if      ( comp( val, lo ) ) val = lo;
+    else if ( comp( hi, val ) ) val = hi;
+}
+
+// generic and SIMD clamp_range_projected():
+
+template<class ForwardIterator, class Projection, class T, class Compare>
+ForwardIterator clamp_range_projected( ForwardIterator first, ForwardIterator last,
+    T const& lo, T const& hi, Projection proj, Compare comp, std::false_type )
+{
+    for ( ; first != last; ++first )
+        clamp_in_place<T>( invoke_projection( proj, *first ), lo, hi, comp, std::is_arithmetic<T>() );
+
+    return first;
+}
+
+// only AVX-512 has masked loads and stores, see use_simd_projected:
+
+#if CLAMP_HAVE_AVX512F
+
+template<class ContiguousIterator, class M, class C, class Compare>
+ContiguousIterator clamp_range_projected( ContiguousIterator first, ContiguousIterator last,
+    M const& lo, M const& hi, M C::* pm, Compare, std::true_type )
+{
+    if ( first != last )
+        simd::clamp_strided_n<M>( std::addressof( ( *first ).*pm ), static_cast<std::size_t>( last - first ),
+            sizeof(C) / sizeof(M), simd_lo<Compare>( lo, hi ), simd_hi<Compare>( lo, hi ) );
+
+    return last;
+}
+
+#endif // CLAMP_HAVE_AVX512F
+
+template<class RandomAccessIterator, class Projection, class T, class Compare>
+RandomAccessIterator parallel_clamp_range_projected( RandomAccessIterator first, RandomAccessIterator last,
+    T const& lo, T const& hi, Projection proj, Compare comp, std::true_type )
+{
+    parallel_chunks( static_cast<std::size_t>( last - first ), [=]( std::size_t pos, std::size_t len )
+    {
+        ::clamp_range_projected( first + pos, first + pos + len, lo, hi, proj, comp );
+    });
+
+    return last;
+}
+
+template<class ForwardIterator, class Projection, class T, class Compare>
+ForwardIterator parallel_clamp_range_projected( ForwardIterator first, ForwardIterator last,
+    T const& lo, T const& hi, Projection proj, Compare comp, std::false_type )
+{
+    return ::clamp_range_projected( first, last, lo, hi, proj, comp );
+}
+
+} // namespace clamp_detail
+
+// clamp projection of range of values in place:
+
+template<class ForwardIterator, class Projection, class Compare>
+ForwardIterator clamp_range_projected( ForwardIterator first, ForwardIterator last,
+    typename clamp_projected<ForwardIterator, Projection>::type const& lo,
+    typename clamp_projected<ForwardIterator, Projection>::type const& hi, Projection proj, Compare comp )
+{
+    static_assert( std::is_lvalue_reference< decltype( clamp_detail::invoke_projection( proj, *first ) ) >::value,
+        "clamp_range_projected: expect a projection that returns a reference" );
+
+    assert( !comp(hi, lo) );
+
+    return clamp_detail::clamp_range_projected( first, last, lo, hi, proj, comp,
+        clamp_detail::use_simd_projected<ForwardIterator, Projection, Compare>() );
+}
+
+// clamp projection of range of values in place per execution policy:
+
+template<class ExecutionPolicy, class ForwardIterator, class Projection, class Compare>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, ForwardIterator>::type
+clamp_range_projected( ExecutionPolicy&&, ForwardIterator first, ForwardIterator last,
+    typename clamp_projected<ForwardIterator, Projection>::type const& lo,
+    typename clamp_projected<ForwardIterator, Projection>::type const& hi, Projection proj, Compare comp )
+{
+    return clamp_detail::parallel_clamp_range_projected( first, last, lo, hi, proj, comp, std::integral_constant<bool,
+        clamp_detail::is_parallel<typename std::decay<ExecutionPolicy>::type>::value &&
+        clamp_detail::is_random_access<ForwardIterator>::value>() );
+}
+
+// Implementation details of clamp_points():
+
+namespace clamp_detail {
+
+// contiguous AoS points are clamped as interleaved channels, with the SIMD
+// kernels of clamp_range_channels():
+
+template<class InputIterator, class OutputIterator,
+         class P = typename std::iterator_traits<InputIterator>::value_type>
+struct use_channels_points : std::integral_constant<bool,
+    is_contiguous_input<InputIterator, P>::value && is_contiguous_output<OutputIterator, P>::value > {};
+
+// generic and channels clamp_points():
+
+template<class InputIterator, class OutputIterator, class T, std::size_t N, class Compare>
+OutputIterator clamp_points( InputIterator first, InputIterator last, OutputIterator out,
+    clamp_box<T, N> const& box, Compare comp, std::false_type )
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type point;
+
+    for ( ; first != last; ++first, ++out )
+    {
+        point p = *first;
+        T c[N];
+
+        std::memcpy( c, std::addressof( p ), sizeof p );
+
+        for ( std::size_t k = 0; k != N; ++k )
+            c[k] = clamp_fast<T>( c[k], box.lo[k], box.hi[k], comp, std::is_arithmetic<T>() );
+
+        std::memcpy( std::addressof( p ), c, sizeof p );
+
+        *out = p;
+    }
+    return out;
+}
+
+template<class ContiguousIterator, class OutputIterator, class T, std::size_t N, class Compare>
+OutputIterator clamp_points( ContiguousIterator first, ContiguousIterator last, OutputIterator out,
+    clamp_box<T, N> const& box, Compare comp, std::true_type )
+{
+    if ( first == last )
+        return out;
+
+    std::size_t const n = static_cast<std::size_t>( last - first );
+
+    T const * const src = reinterpret_cast<T const *>( std::addressof( *first ) );
+    T       * const dst = reinterpret_cast<T       *>( std::addressof( *out   ) );
+
+    ::clamp_range_channels( src, src + n * N, dst, box.lo, box.hi, comp );
+
+    return out + n;
+}
+
+// clamp SoA points [pos, pos + len), one axis after the other:
+
+template<class T, std::size_t N, class Compare>
+void clamp_axes( std::array<T *, N> const& axes, std::size_t pos, std::size_t len,
+    clamp_box<T, N> const& box, Compare comp )
+{
+    for ( std::size_t k = 0; k != N; ++k )
+        ::clamp_range( axes[k] + pos, axes[k] + pos + len, axes[k] + pos, box.lo[k], box.hi[k], comp );
+}
+
+template<class RandomAccessIterator, class OutputIterator, class T, std::size_t N, class Compare>
+OutputIterator parallel_clamp_points( RandomAccessIterator first, RandomAccessIterator last, OutputIterator out,
+    clamp_box<T, N> const& box, Compare comp, std::true_type )
+{
+    std::size_t const n = static_cast<std::size_t>( last - first );
+
+    parallel_chunks( n, [=]( std::size_t pos, std::size_t len )
+    {
+        ::clamp_points( first + pos, first + pos + len, out + pos, box, comp );
+    });
+
+    return out + n;
+}
+
+template<class InputIterator, class OutputIterator, class T, std::size_t N, class Compare>
+OutputIterator parallel_clamp_points( InputIterator first, InputIterator last, OutputIterator out,
+    clamp_box<T, N> const& box, Compare comp, std::false_type )
+{
+    return ::clamp_points( first, last, out, box, comp );
+}
+
+// clamp SoA points in chunks of all axes, so that a chunk's coordinates are
+// clamped by one thread:
+
+template<class T, std::size_t N, class Compare>
+void parallel_clamp_points( std::array<T *, N> const& axes, std::size_t n,
+    clamp_box<T, N> const& box, Compare comp, std::true_type )
+{
+    parallel_chunks( n, [=]( std::size_t pos, std::size_t len )
+    {
+        clamp_axes( axes, pos, len, box, comp );
+    });
+}
+
+template<class T, std::size_t N, class Compare>
+void parallel_clamp_points( std::array<T *, N> const& axes, std::size_t n,
+    clamp_box<T, N> const& box, Compare comp, std::false_type )
+{
+    clamp_axes( axes, 0, n, box, comp );
+}
+
+} // namespace clamp_detail
+
+// clamp AoS points into box:
+
+template<class InputIterator, class OutputIterator, class T, std::size_t N, class Compare>
+OutputIterator clamp_points( InputIterator first, InputIterator last, OutputIterator out,
+    clamp_box<T, N> const& box, Compare comp )
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type point;
+
+    static_assert( N > 0, "clamp_points: expect at least one dimension" );
+    static_assert( sizeof(point) == N * sizeof(T) && std::is_standard_layout<point>::value && std::is_trivially_copyable<point>::value,
+        "clamp_points: expect points of N coordinates of the box's value type" );
+
+    for ( std::size_t k = 0; k != N; ++k )
+        assert( !comp( box.hi[k], box.lo[k] ) );
+
+    return clamp_detail::clamp_points( first, last, out, box, comp,
+        clamp_detail::use_channels_points<InputIterator, OutputIterator>() );
+}
+
+// clamp SoA points into box in place:
+
+template<class T, std::size_t N, class Compare>
+void clamp_points( std::array<T *, N> const& axes, std::size_t n,
+    clamp_box<T, N> const& box, Compare comp )
+{
+    static_assert( N > 0, "clamp_points: expect at least one dimension" );
+
+    for ( std::size_t k = 0; k != N; ++k )
+        assert( !comp( box.hi[k], box.lo[k] ) );
+
+    clamp_detail::clamp_axes( axes, 0, n, box, comp );
+}
+
+// clamp points per execution policy:
+
+template<class ExecutionPolicy, class InputIterator, class OutputIterator, class T, std::size_t N, class Compare>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, OutputIterator>::type
+clamp_points( ExecutionPolicy&&, InputIterator first, InputIterator last, OutputIterator out,
+    clamp_box<T, N> const& box, Compare comp )
+{
+    return clamp_detail::parallel_clamp_points( first, last, out, box, comp, std::integral_constant<bool,
+        clamp_detail::is_parallel<typename std::decay<ExecutionPolicy>::type>::value &&
+        clamp_detail::use_parallel<InputIterator, OutputIterator>::value>() );
+}
+
+template<class ExecutionPolicy, class T, std::size_t N, class Compare>
+typename clamp_execution::enable_if_policy<ExecutionPolicy, void>::type
+clamp_points( ExecutionPolicy&&, std::array<T *, N> const& axes, std::size_t n,
+    clamp_box<T, N> const& box, Compare comp )
 {
-    using arg_type = decltype(lo);
+    for ( std::size_t k = 0; k != N; ++k )
+        assert( !comp( box.hi[k], box.lo[k] ) );
 
-    return std::transform(
-        first, last, out, [&](arg_type val) -> arg_type { return clamp(val, lo, hi, comp); } );
+    clamp_detail::parallel_clamp_points( axes, n, box, comp,
+        std::integral_constant<bool, clamp_detail::is_parallel<typename std::decay<ExecutionPolicy>::type>::value>() );
 }
 
 #endif // CLAMP_H_INCLUDED
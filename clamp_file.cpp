@@ -0,0 +1,288 @@
+// Copyright 2014-2015 Martin Moene.
+//
+// Use, modification, and distribution is subject to the Boost Software
+// License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// clamp_file - clamp a raw binary array file in place or to a second file.
+//
+// Usage: clamp_file --type=T --lo=L --hi=H input [output]
+//        clamp_file --type=T --lo=L --hi=H -
+//
+// T is one of int8, uint8, int16, uint16, int32, uint32, int64, uint64, float
+// and double, in native byte order. The files are memory mapped and clamped
+// in windows, with read-ahead of the next window requested while the current
+// one is clamped, so that memory use does not grow with the file size. To a
+// second file, a window is clamped with clamp_range( clamp_execution::par,
+// ... ). Without output, or with an output that is the input file, the input
+// file is clamped in place with clamp_range( clamp_store::changed, ... ), so
+// that pages already in range are not written back. With input '-', standard
+// input is clamped to standard output with clamp_stream(), as a pipeline
+// filter.
+//
+// Requires POSIX mmap().
+
+#if __cplusplus < 201103L
+#error Compile as C++11 or newer.
+#else // __cplusplus < 201103L
+
+#include "clamp.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+struct options
+{
+    std::string type;
+    long double lo = 0;
+    long double hi = 0;
+    bool have_lo = false;
+    bool have_hi = false;
+    std::string input;
+    std::string output;
+};
+
+[[noreturn]] void usage( char const * argv0 )
+{
+    std::fprintf( stderr,
+        "Usage: %s --type=T --lo=L --hi=H input [output]\n"
+        "       %s --type=T --lo=L --hi=H -\n"
+        "T: int8, uint8, int16, uint16, int32, uint32, int64, uint64, float, double\n", argv0, argv0 );
+    std::exit( EXIT_FAILURE );
+}
+
+[[noreturn]] void fail( std::string const & what, std::string const & name )
+{
+    std::fprintf( stderr, "clamp_file: %s '%s': %s\n", what.c_str(), name.c_str(), std::strerror( errno ) );
+    std::exit( EXIT_FAILURE );
+}
+
+// file descriptor and memory mapping, released on destruction:
+
+class mapped_file
+{
+public:
+    mapped_file( std::string const & name, int flags, std::size_t size_if_created = 0 )
+    : fd( ::open( name.c_str(), flags, 0644 ) ), data( nullptr ), size( 0 )
+    {
+        if ( fd < 0 )
+            fail( "cannot open", name );
+
+        // reserve the blocks of a created file, so that a full disk is
+        // reported here, not as SIGBUS on a store to a sparse mapping;
+        // posix_fallocate() returns the error instead of setting errno:
+
+        if ( flags & O_CREAT )
+        {
+            if ( size_if_created > 0 )
+            {
+                if ( int const error = ::posix_fallocate( fd, 0, static_cast<off_t>( size_if_created ) ) )
+                {
+                    errno = error;
+                    fail( "cannot allocate", name );
+                }
+            }
+            size = size_if_created;
+        }
+        else
+        {
+            struct stat st;
+            if ( ::fstat( fd, &st ) != 0 )
+                fail( "cannot stat", name );
+            size = static_cast<std::size_t>( st.st_size );
+        }
+
+        if ( size == 0 )
+            return;
+
+        int const prot = ( flags & O_ACCMODE ) == O_RDONLY ? PROT_READ : PROT_READ | PROT_WRITE;
+
+        data = ::mmap( nullptr, size, prot, MAP_SHARED, fd, 0 );
+
+        if ( data == MAP_FAILED )
+            fail( "cannot map", name );
+    }
+
+    ~mapped_file()
+    {
+        if ( data )
+            ::munmap( data, size );
+        ::close( fd );
+    }
+
+    mapped_file( mapped_file const & ) = delete;
+    mapped_file & operator=( mapped_file const & ) = delete;
+
+    int fd;
+    void * data;
+    std::size_t size;
+};
+
+// true if both names refer to an existing file, such as via a link; opening
+// the output with O_TRUNC would then discard the input:
+
+bool same_file( std::string const & a, std::string const & b )
+{
+    struct stat sa, sb;
+
+    return ::stat( a.c_str(), &sa ) == 0 && ::stat( b.c_str(), &sb ) == 0
+        && sa.st_dev == sb.st_dev && sa.st_ino == sb.st_ino;
+}
+
+// clamp mapped range [first, last) in windows of window_bytes, requesting
+// read-ahead of the next window while the current one is clamped, rather than
+// of the whole mapping at once; a multiple of the page size, so that each
+// window starts page aligned, as madvise() requires:
+
+std::size_t const window_bytes = 64 * 1024 * 1024;
+
+template< typename T, typename Clamp >
+void clamp_windows( T * first, T * last, Clamp clamp_window )
+{
+    std::size_t const window = window_bytes / sizeof( T );
+
+    ::madvise( first, std::min<std::size_t>( window, last - first ) * sizeof( T ), MADV_WILLNEED );
+
+    for ( T * pos = first; pos != last; )
+    {
+        T * const end = pos + std::min<std::size_t>( window, last - pos );
+
+        if ( end != last )
+            ::madvise( end, std::min<std::size_t>( window, last - end ) * sizeof( T ), MADV_WILLNEED );
+
+        clamp_window( pos, end );
+        pos = end;
+    }
+}
+
+template< typename T >
+int clamp_file( options const & opt )
+{
+    T const lo = clamp_cast<T>( opt.lo );
+    T const hi = clamp_cast<T>( opt.hi );
+
+    if ( hi < lo )
+    {
+        std::fprintf( stderr, "clamp_file: expect lo <= hi\n" );
+        return EXIT_FAILURE;
+    }
+
+    if ( opt.input == "-" )
+    {
+        std::ios_base::sync_with_stdio( false );
+
+        clamp_stream( std::cin, std::cout, lo, hi );
+
+        return std::cout.flush() && !std::cin.bad() ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    bool const in_place = opt.output.empty() || same_file( opt.input, opt.output );
+
+    mapped_file in( opt.input, in_place ? O_RDWR : O_RDONLY );
+
+    if ( in.size % sizeof( T ) != 0 )
+    {
+        std::fprintf( stderr, "clamp_file: size of '%s' is not a multiple of %zu bytes\n", opt.input.c_str(), sizeof( T ) );
+        return EXIT_FAILURE;
+    }
+
+    T * const first = static_cast<T *>( in.data );
+    T * const last  = first + in.size / sizeof( T );
+
+    if ( in_place )
+    {
+        clamp_windows( first, last, [&]( T * pos, T * end )
+        {
+            clamp_range( clamp_store::changed, pos, end, pos, lo, hi );
+        });
+    }
+    else
+    {
+        mapped_file out( opt.output, O_RDWR | O_CREAT | O_TRUNC, in.size );
+
+        T * const dest = static_cast<T *>( out.data );
+
+        clamp_windows( first, last, [&]( T * pos, T * end )
+        {
+            clamp_range( clamp_execution::par, pos, end, dest + ( pos - first ), lo, hi );
+        });
+    }
+    return EXIT_SUCCESS;
+}
+
+// bound given as text, rejecting trailing text, out of range values and NaN:
+
+long double parse_bound( std::string const & arg, char const * text )
+{
+    char * end = nullptr;
+
+    errno = 0;
+    long double const value = std::strtold( text, &end );
+
+    if ( end == text || *end != '\0' || errno == ERANGE || value != value )
+    {
+        std::fprintf( stderr, "clamp_file: invalid bound '%s'\n", arg.c_str() );
+        std::exit( EXIT_FAILURE );
+    }
+    return value;
+}
+
+options parse( int argc, char * argv[] )
+{
+    options opt;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        std::string const arg = argv[i];
+
+        if      ( arg.compare( 0, 7, "--type=" ) == 0 ) { opt.type = arg.substr( 7 ); }
+        else if ( arg.compare( 0, 5, "--lo="   ) == 0 ) { opt.lo = parse_bound( arg, arg.c_str() + 5 ); opt.have_lo = true; }
+        else if ( arg.compare( 0, 5, "--hi="   ) == 0 ) { opt.hi = parse_bound( arg, arg.c_str() + 5 ); opt.have_hi = true; }
+        else if ( arg.compare( 0, 2, "--"      ) == 0 ) { usage( argv[0] ); }
+        else if ( opt.input.empty()  ) { opt.input  = arg; }
+        else if ( opt.output.empty() ) { opt.output = arg; }
+        else                           { usage( argv[0] ); }
+    }
+
+    if ( opt.type.empty() || !opt.have_lo || !opt.have_hi || opt.input.empty() || ( opt.input == "-" && !opt.output.empty() ) )
+        usage( argv[0] );
+
+    return opt;
+}
+
+} // anonymous namespace
+
+int main( int argc, char * argv[] )
+{
+    options const opt = parse( argc, argv );
+
+    if ( opt.type == "int8"   ) return clamp_file<std::int8_t  >( opt );
+    if ( opt.type == "uint8"  ) return clamp_file<std::uint8_t >( opt );
+    if ( opt.type == "int16"  ) return clamp_file<std::int16_t >( opt );
+    if ( opt.type == "uint16" ) return clamp_file<std::uint16_t>( opt );
+    if ( opt.type == "int32"  ) return clamp_file<std::int32_t >( opt );
+    if ( opt.type == "uint32" ) return clamp_file<std::uint32_t>( opt );
+    if ( opt.type == "int64"  ) return clamp_file<std::int64_t >( opt );
+    if ( opt.type == "uint64" ) return clamp_file<std::uint64_t>( opt );
+    if ( opt.type == "float"  ) return clamp_file<float        >( opt );
+    if ( opt.type == "double" ) return clamp_file<double       >( opt );
+
+    usage( argv[0] );
+}
+
+#endif //__cplusplus < 201103L
+
+// g++ -Wall -std=c++11 -pthread -O2 -o clamp_file clamp_file.cpp
@@ -1 +1 @@
-g++ -Wall -std=c++11 -o test_clamp.exe test_clamp.cpp && test_clamp
+g++ -Wall -std=c++11 -pthread -o test_clamp.exe test_clamp.cpp && test_clamp
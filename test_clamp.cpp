@@ -17,12 +17,181 @@
 #include "lest.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 
 using test = lest::test;
 
 std::ostringstream dev_null;
 
+// values for the differential tests of the SIMD kernels, covering negative
+// values and, for unsigned types, values near the type's maximum:
+
+template< typename T >
+std::vector<T> test_values( int n )
+{
+    std::vector<T> v;
+    for ( int i = 0; i < n; ++i )
+        v.push_back( static_cast<T>( ( i * 37 ) % 251 - 125 ) );
+    return v;
+}
+
+template< typename T >
+std::string to_text( T const & x )
+{
+    std::ostringstream os;
+    os << +x;
+    return os.str();
+}
+
+// NaN is the same as NaN; 16-bit floating point values compare bitwise, so
+// that -0.0 differs from 0.0:
+
+template< typename T >
+bool same_value( T const & x, T const & y )
+{
+    return x == y || ( x != x && y != y );
+}
+
+inline bool same_value( clamp_half const & x, clamp_half const & y )
+{
+    return x.bits == y.bits || ( x != x && y != y );
+}
+
+inline bool same_value( clamp_bfloat16 const & x, clamp_bfloat16 const & y )
+{
+    return x.bits == y.bits || ( x != x && y != y );
+}
+
+template< typename U, typename Expect >
+std::string difference( std::string const & where, std::vector<U> const & out, std::size_t offset, std::size_t len, Expect expect )
+{
+    for ( std::size_t i = 0; i < out.size(); ++i )
+    {
+        bool const inside = offset <= i && i < offset + len;
+        U const wanted = inside ? expect( i - offset ) : U( 1 );
+
+        if ( !same_value( out[i], wanted ) )
+            return where + ": out[" + std::to_string( long( i ) - long( offset ) ) + "] is " + to_text( out[i] ) + ", expected " + to_text( wanted );
+    }
+    return "";
+}
+
+template< typename U, typename T, typename Clamp, typename Expect >
+std::string in_place_difference( std::vector<T> const &, std::size_t, Clamp, Expect, std::false_type )
+{
+    return "";
+}
+
+template< typename U, typename T, typename Clamp, typename Expect >
+std::string in_place_difference( std::vector<T> const & in, std::size_t len, Clamp clamp_fn, Expect expect, std::true_type )
+{
+    std::vector<T> buffer( in.begin(), in.begin() + len );
+    buffer.push_back( T( 1 ) );
+
+    std::string const where = "length " + std::to_string( len ) + ", in place";
+
+    if ( clamp_fn( buffer.data(), buffer.data() + len, buffer.data() ) != buffer.data() + len )
+        return where + ": wrong end of output";
+
+    return difference( where, buffer, 0, len, expect );
+}
+
+// the first difference of clamp_fn( first, last, out ), which returns the end
+// of the output, from out[i] == expect( i ), for all lengths up to in.size(),
+// for all offsets of the output in a cache line and, if U is T, in place; a
+// write outside [out, out + length) is a difference too:
+
+template< typename U, typename T, typename Clamp, typename Expect >
+std::string first_difference( std::vector<T> const & in, Clamp clamp_fn, Expect expect )
+{
+    std::size_t const line = 64 / sizeof(U);
+
+    for ( std::size_t len = 0; len <= in.size(); ++len )
+    {
+        for ( std::size_t offset = 0; offset < line; ++offset )
+        {
+            std::vector<U> out( offset + len + 1, U( 1 ) );
+
+            std::string const where = "length " + std::to_string( len ) + ", offset " + std::to_string( offset );
+
+            if ( clamp_fn( in.data(), in.data() + len, out.data() + offset ) != out.data() + offset + len )
+                return where + ": wrong end of output";
+
+            std::string const diff = difference( where, out, offset, len, expect );
+            if ( !diff.empty() )
+                return diff;
+        }
+
+        std::string const diff = in_place_difference<U>( in, len, clamp_fn, expect, std::is_same<T, U>() );
+        if ( !diff.empty() )
+            return diff;
+    }
+    return "";
+}
+
+// records for clamp_range_projected() and clamp_points():
+
+struct point2 { float x, y; };
+struct point3 { float x, y, z; };
+struct order  { std::int64_t id; double price; std::int32_t qty; };
+struct sample { float a[6]; float v; };
+struct pixel  { std::uint8_t r, g, b, a; };
+
+// binary stream (de)serialization for clamp_stream():
+
+template< typename T >
+std::string to_bytes( std::vector<T> const & v )
+{
+    return std::string( reinterpret_cast<char const *>( v.data() ), v.size() * sizeof(T) );
+}
+
+template< typename T >
+std::vector<T> from_bytes( std::string const & s )
+{
+    std::vector<T> v( s.size() / sizeof(T) );
+    std::copy( s.begin(), s.begin() + v.size() * sizeof(T), reinterpret_cast<char *>( v.data() ) );
+    return v;
+}
+
+// stream buffer that throws once its bytes are read:
+
+struct failing_buf : std::streambuf
+{
+    explicit failing_buf( std::string bytes ) : bytes( bytes )
+    {
+        setg( &this->bytes[0], &this->bytes[0], &this->bytes[0] + this->bytes.size() );
+    }
+
+    int_type underflow() override
+    {
+        throw std::runtime_error( "failing_buf: read failure" );
+    }
+
+    std::string bytes;
+};
+
+// coordinates of AoS points for clamp_points():
+
+template< typename T, typename P >
+std::vector<T> coordinates( std::vector<P> const & points )
+{
+    std::vector<T> c( points.size() * sizeof(P) / sizeof(T) );
+    if ( !c.empty() )
+        std::memcpy( c.data(), points.data(), c.size() * sizeof(T) );
+    return c;
+}
+
 const test specification[] =
 {
     // test prerequisites:
@@ -289,6 +458,2049 @@ const test specification[] =
         EXPECT( ( out == a.end() ) );
         EXPECT(     a == b         );
     },
+
+    CASE( "clamp_range() on contiguous data clamps at the extremes of the type" )
+    {
+        std::vector<std::uint8_t> u( 100, 255 );
+        u[0] = 0; u[99] = 49;
+
+        std::vector<std::int64_t> i( 20, std::numeric_limits<std::int64_t>::max() );
+        i[0] = std::numeric_limits<std::int64_t>::min(); i[19] = -1;
+
+        std::vector<std::uint64_t> w( 20, std::numeric_limits<std::uint64_t>::max() );
+        w[0] = 0; w[19] = std::uint64_t( 1 ) << 63;
+
+        EXPECT( ( clamp_range( u.begin(), u.end(), u.begin(), std::uint8_t( 50 ), std::uint8_t( 70 ) ) == u.end() ) );
+        EXPECT( ( clamp_range( i.begin(), i.end(), i.begin(), std::int64_t( -5 ), std::int64_t( 5 ) ) == i.end() ) );
+        EXPECT( ( clamp_range( w.begin(), w.end(), w.begin(), std::uint64_t( 5 ), std::uint64_t( 7 ) ) == w.end() ) );
+
+        EXPECT( u[0] == 50 ); EXPECT( u[1] == 70 ); EXPECT( u[98] == 70 ); EXPECT( u[99] == 50 );
+        EXPECT( i[0] == -5 ); EXPECT( i[1] ==  5 ); EXPECT( i[18] ==  5 ); EXPECT( i[19] == -1 );
+        EXPECT( w[0] == 5U ); EXPECT( w[1] == 7U ); EXPECT( w[18] == 7U ); EXPECT( w[19] == 7U );
+    },
+
+    CASE( "clamp_range() on contiguous float data handles NaN, infinity and -0.0 like clamp()" )
+    {
+        float const nan = std::numeric_limits<float>::quiet_NaN();
+        float const inf = std::numeric_limits<float>::infinity();
+
+        std::vector<float> a( 37, 9.f );
+        a[1] = -inf; a[2] = inf; a[3] = a[36] = nan; a[4] = -0.f; a[35] = 3.f;
+
+        std::vector<double> b( 37, -0. );
+        b[36] = 0.;
+
+        clamp_range( a.begin(), a.end(), a.begin(), -7.f, 7.f );
+        clamp_range( b.begin(), b.end(), b.begin(), 0., 1. );
+
+        EXPECT( a[0]  ==  7.f );
+        EXPECT( a[1]  == -7.f );
+        EXPECT( a[2]  ==  7.f );
+        EXPECT( a[3]  != a[3] );
+        EXPECT( a[36] != a[36] );
+        EXPECT( std::signbit( a[4] ) );
+        EXPECT( a[35] ==  3.f );
+        EXPECT( std::signbit( b[0] ) );
+        EXPECT( std::signbit( b[35] ) );
+        EXPECT( !std::signbit( b[36] ) );
+    },
+
+    CASE( "clamp_range() on contiguous arithmetic data agrees with clamp() for all lengths" )
+    {
+        typedef std::int8_t i8; typedef std::uint8_t u8; typedef std::int16_t i16; typedef std::uint16_t u16;
+        typedef std::int32_t i32; typedef std::uint32_t u32; typedef std::int64_t i64; typedef std::uint64_t u64;
+
+        auto const a = test_values<i8 >( 200 );
+        auto const b = test_values<u8 >( 200 );
+        auto const c = test_values<i16>( 100 );
+        auto const d = test_values<u16>( 100 );
+        auto const e = test_values<i32>(  50 );
+        auto const f = test_values<u32>(  50 );
+        auto const g = test_values<i64>(  50 );
+        auto const h = test_values<u64>(  50 );
+        auto const x = test_values<float >( 50 );
+        auto const y = test_values<double>( 50 );
+
+        EXPECT( first_difference<i8 >( a, []( i8  const * p, i8  const * q, i8  * o ) { return clamp_range( p, q, o, i8 (-50), i8 (70) ); },
+                                          [&]( std::size_t k ) { return clamp( a[k], i8 (-50), i8 (70) ); } ) == "" );
+        EXPECT( first_difference<u8 >( b, []( u8  const * p, u8  const * q, u8  * o ) { return clamp_range( p, q, o, u8 ( 50), u8 (70) ); },
+                                          [&]( std::size_t k ) { return clamp( b[k], u8 ( 50), u8 (70) ); } ) == "" );
+        EXPECT( first_difference<i16>( c, []( i16 const * p, i16 const * q, i16 * o ) { return clamp_range( p, q, o, i16(-50), i16(70) ); },
+                                          [&]( std::size_t k ) { return clamp( c[k], i16(-50), i16(70) ); } ) == "" );
+        EXPECT( first_difference<u16>( d, []( u16 const * p, u16 const * q, u16 * o ) { return clamp_range( p, q, o, u16( 50), u16(70) ); },
+                                          [&]( std::size_t k ) { return clamp( d[k], u16( 50), u16(70) ); } ) == "" );
+        EXPECT( first_difference<i32>( e, []( i32 const * p, i32 const * q, i32 * o ) { return clamp_range( p, q, o, i32(-50), i32(70) ); },
+                                          [&]( std::size_t k ) { return clamp( e[k], i32(-50), i32(70) ); } ) == "" );
+        EXPECT( first_difference<u32>( f, []( u32 const * p, u32 const * q, u32 * o ) { return clamp_range( p, q, o, u32( 50), u32(70) ); },
+                                          [&]( std::size_t k ) { return clamp( f[k], u32( 50), u32(70) ); } ) == "" );
+        EXPECT( first_difference<i64>( g, []( i64 const * p, i64 const * q, i64 * o ) { return clamp_range( p, q, o, i64(-50), i64(70) ); },
+                                          [&]( std::size_t k ) { return clamp( g[k], i64(-50), i64(70) ); } ) == "" );
+        EXPECT( first_difference<u64>( h, []( u64 const * p, u64 const * q, u64 * o ) { return clamp_range( p, q, o, u64( 50), u64(70) ); },
+                                          [&]( std::size_t k ) { return clamp( h[k], u64( 50), u64(70) ); } ) == "" );
+        EXPECT( first_difference<float >( x, []( float  const * p, float  const * q, float  * o ) { return clamp_range( p, q, o, -50.f, 70.f ); },
+                                             [&]( std::size_t k ) { return clamp( x[k], -50.f, 70.f ); } ) == "" );
+        EXPECT( first_difference<double>( y, []( double const * p, double const * q, double * o ) { return clamp_range( p, q, o, -50. , 70.  ); },
+                                             [&]( std::size_t k ) { return clamp( y[k], -50. , 70.  ); } ) == "" );
+
+        EXPECT( first_difference<i8 >( a, []( i8  const * p, i8  const * q, i8  * o ) { return clamp_range( p, q, o, i8 (70), i8 (-50), std14::greater<>() ); },
+                                          [&]( std::size_t k ) { return clamp( a[k], i8 (70), i8 (-50), std14::greater<>() ); } ) == "" );
+        EXPECT( first_difference<u16>( d, []( u16 const * p, u16 const * q, u16 * o ) { return clamp_range( p, q, o, u16(70), u16( 50), std14::greater<>() ); },
+                                          [&]( std::size_t k ) { return clamp( d[k], u16(70), u16( 50), std14::greater<>() ); } ) == "" );
+        EXPECT( first_difference<i32>( e, []( i32 const * p, i32 const * q, i32 * o ) { return clamp_range( p, q, o, i32(70), i32(-50), std14::greater<>() ); },
+                                          [&]( std::size_t k ) { return clamp( e[k], i32(70), i32(-50), std14::greater<>() ); } ) == "" );
+        EXPECT( first_difference<float >( x, []( float  const * p, float  const * q, float  * o ) { return clamp_range( p, q, o, 70.f, -50.f, std14::greater<>() ); },
+                                             [&]( std::size_t k ) { return clamp( x[k], 70.f, -50.f, std14::greater<>() ); } ) == "" );
+        EXPECT( first_difference<double>( y, []( double const * p, double const * q, double * o ) { return clamp_range( p, q, o, 70. , -50. , std14::greater<>() ); },
+                                             [&]( std::size_t k ) { return clamp( y[k], 70. , -50. , std14::greater<>() ); } ) == "" );
+    },
+
+    CASE( "clamp_range() with non-contiguous iterators clamps range successfully" )
+    {
+        std::list<int>       a{ -7,1,2,3,4,5,6,7,8,9, };
+        std::list<int> const b{  3,3,3,3,4,5,6,7,7,7, };
+
+        auto out = clamp_range( a.begin(), a.end(), a.begin(), 3, 7 );
+
+        EXPECT( ( out == a.end() ) );
+        EXPECT( ( a == b )         );
+    },
+
+    // clamp_range( policy, first, last, out, lo, hi[, pred] ):
+
+    CASE( "clamp_range(policy,...) clamps a large range like clamp_range()" )
+    {
+        std::vector<int> a( 3 * CLAMP_PARALLEL_THRESHOLD + 17 );
+        std::iota( a.begin(), a.end(), -1000 );
+
+        std::vector<int> seq( a.size() ), par( a.size() ), par_unseq( a.size() ), expect( a.size() );
+
+        int const lo = 10, hi = int( a.size() / 2 );
+
+        clamp_range( a.begin(), a.end(), expect.begin(), lo, hi );
+
+        EXPECT( ( clamp_range( clamp_execution::seq      , a.begin(), a.end(), seq.begin()      , lo, hi ) == seq.end()       ) );
+        EXPECT( ( clamp_range( clamp_execution::par      , a.begin(), a.end(), par.begin()      , lo, hi ) == par.end()       ) );
+        EXPECT( ( clamp_range( clamp_execution::par_unseq, a.begin(), a.end(), par_unseq.begin(), lo, hi ) == par_unseq.end() ) );
+
+        EXPECT( seq       == expect );
+        EXPECT( par       == expect );
+        EXPECT( par_unseq == expect );
+    },
+
+    CASE( "clamp_range(policy,...) clamps a small range and a non-random-access range" )
+    {
+        std::vector<int>       a{ -7,1,2,3,4,5,6,7,8,9, };
+        std::list  <int>       l{ -7,1,2,3,4,5,6,7,8,9, };
+        std::vector<int> const b{  3,3,3,3,4,5,6,7,7,7, };
+        std::list  <int> const c{  3,3,3,3,4,5,6,7,7,7, };
+
+        EXPECT( ( clamp_range( clamp_execution::par, a.begin(), a.end(), a.begin(), 7, 3, std14::greater<>() ) == a.end() ) );
+        EXPECT( ( clamp_range( clamp_execution::par, l.begin(), l.end(), l.begin(), 3, 7 ) == l.end() ) );
+
+        EXPECT( a == b );
+        EXPECT( ( l == c ) );
+    },
+
+    CASE( "clamp_range(policy,...) propagates an exception from the predicate" )
+    {
+        std::vector<int> a( 2 * CLAMP_PARALLEL_THRESHOLD, 5 );
+        a.back() = 42;
+
+        auto const throwing_less = []( int x, int y ) -> bool
+        {
+            if ( x == 42 || y == 42 ) throw std::runtime_error( "42" );
+            return x < y;
+        };
+
+        EXPECT_THROWS_AS( clamp_range( clamp_execution::par, a.begin(), a.end(), a.begin(), 3, 7, throwing_less ), std::runtime_error );
+    },
+
+    // clamp_value( val, lo, hi[, pred] ) returns a copy:
+
+    CASE( "clamp_value(v,lo,hi) is a valid constexpr expression" )
+    {
+        constexpr auto c = clamp_value( 7, 5, 9 );
+        use(c);
+    },
+
+    CASE( "clamp_value(v,lo,hi) clamps like clamp(v,lo,hi)" )
+    {
+        for ( int v = -3; v <= 13; ++v )
+        {
+            EXPECT( clamp( v, 5, 9 ) == clamp_value( v, 5, 9 ) );
+            EXPECT( clamp( v, 9, 5, std14::greater<>() ) == clamp_value( v, 9, 5, std14::greater<>() ) );
+            EXPECT( approx( clamp( v + .5, 5., 9. ), clamp_value( v + .5, 5., 9. ) ) );
+        }
+    },
+
+    CASE( "clamp_value(v,lo,hi) propagates NaN like clamp(v,lo,hi)" )
+    {
+        double const nan = std::numeric_limits<double>::quiet_NaN();
+
+        EXPECT( clamp_value( nan, 5., 9. ) != clamp_value( nan, 5., 9. ) );
+        EXPECT( clamp_value( nan, 9., 5., std14::greater<>() ) != clamp_value( nan, 9., 5., std14::greater<>() ) );
+    },
+
+    CASE( "clamp_value(v,lo,hi) works with a non-arithmetic type" )
+    {
+        EXPECT( std::string("c") == clamp_value( std::string("a"), std::string("c"), std::string("f") ) );
+        EXPECT( std::string("d") == clamp_value( std::string("d"), std::string("c"), std::string("f") ) );
+        EXPECT( std::string("f") == clamp_value( std::string("g"), std::string("c"), std::string("f") ) );
+    },
+
+    // clamp_cast<To>( val ), clamp_convert_range( first, last, out ):
+
+    CASE( "clamp_cast<To>(v) is a valid constexpr expression" )
+    {
+        constexpr auto c = clamp_cast<std::uint8_t>( 300 );
+        use(c);
+    },
+
+    CASE( "clamp_cast<To>(v) saturates integers at the target type's range" )
+    {
+        EXPECT(   0 == clamp_cast<std::uint8_t>( -5 ) );
+        EXPECT(   7 == clamp_cast<std::uint8_t>(  7 ) );
+        EXPECT( 255 == clamp_cast<std::uint8_t>( 300 ) );
+
+        EXPECT( -32768 == clamp_cast<std::int16_t>( -100000L ) );
+        EXPECT(  32767 == clamp_cast<std::int16_t>(  100000L ) );
+
+        EXPECT( std::numeric_limits<std::int32_t>::max() == clamp_cast<std::int32_t>( 4000000000U ) );
+        EXPECT( 0U == clamp_cast<std::uint64_t>( std::int64_t(-1) ) );
+        EXPECT( 5U == clamp_cast<std::uint64_t>( std::int64_t( 5) ) );
+        EXPECT( std::numeric_limits<std::int64_t>::max() == clamp_cast<std::int64_t>( std::numeric_limits<std::uint64_t>::max() ) );
+    },
+
+    CASE( "clamp_cast<To>(v) saturates and truncates floating point to integer, NaN to 0" )
+    {
+        EXPECT(  32767 == clamp_cast<std::int16_t>(  1e10f ) );
+        EXPECT( -32768 == clamp_cast<std::int16_t>( -1e10f ) );
+        EXPECT(     -2 == clamp_cast<std::int16_t>( -2.7f  ) );
+        EXPECT(      0 == clamp_cast<std::int16_t>( std::numeric_limits<float>::quiet_NaN() ) );
+
+        EXPECT( std::numeric_limits<std::int32_t>::max() == clamp_cast<std::int32_t>( 2147483648.f ) );
+        EXPECT( std::numeric_limits<std::int32_t>::min() == clamp_cast<std::int32_t>( -2147483904.f ) );
+        EXPECT( std::numeric_limits<std::int64_t>::max() == clamp_cast<std::int64_t>( 1e300 ) );
+        EXPECT( 0U == clamp_cast<std::uint32_t>( -0.5 ) );
+    },
+
+    CASE( "clamp_cast<To>(v) saturates narrowing floating point conversions" )
+    {
+        EXPECT(  std::numeric_limits<float>::max() == clamp_cast<float>(  1e300 ) );
+        EXPECT( -std::numeric_limits<float>::max() == clamp_cast<float>( -DBL_MAX ) );
+        EXPECT( 1.5f == clamp_cast<float>( 1.5 ) );
+        EXPECT( approx( 3., clamp_cast<double>( 3 ) ) );
+    },
+
+    CASE( "clamp_cast<To>(v) and clamp_convert_range() keep infinities in narrowing floating point conversions" )
+    {
+        double const inf = std::numeric_limits<double>::infinity();
+
+        EXPECT(  std::numeric_limits<float>::infinity() == clamp_cast<float>(  inf ) );
+        EXPECT( -std::numeric_limits<float>::infinity() == clamp_cast<float>( -inf ) );
+
+        std::vector<double> const a{ inf, -inf, 1e300, -1e300, 1.5, -inf, inf, 0., inf, };
+        std::vector<float>  const b{ std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), FLT_MAX, -FLT_MAX, 1.5f,
+                                    -std::numeric_limits<float>::infinity(),  std::numeric_limits<float>::infinity(), 0.f, std::numeric_limits<float>::infinity(), };
+        std::vector<float> c( a.size() );
+
+        clamp_convert_range( a.begin(), a.end(), c.begin() );
+
+        EXPECT( c == b );
+    },
+
+    CASE( "clamp_convert_range() agrees with clamp_cast<To>() for all lengths" )
+    {
+        typedef std::int8_t i8; typedef std::uint8_t u8; typedef std::int16_t i16; typedef std::uint16_t u16;
+        typedef std::int32_t i32; typedef std::uint32_t u32; typedef std::int64_t i64;
+
+        float  const fnan = std::numeric_limits<float >::quiet_NaN();
+        double const dnan = std::numeric_limits<double>::quiet_NaN();
+
+        auto s16 = test_values<i16   >( 80 );
+        auto w16 = test_values<u16   >( 80 );
+        auto s32 = test_values<i32   >( 80 );
+        auto s64 = test_values<i64   >( 80 );
+        auto f32 = test_values<float >( 80 );
+        auto f64 = test_values<double>( 80 );
+
+        s16.insert( s16.begin(), { -32768, 32767, -129, -128, 127, 128, 255, 256, -1, } );
+        w16.insert( w16.begin(), { 0, 65535, 127, 128, 255, 256, 32767, 32768, } );
+        s32.insert( s32.begin(), { INT32_MIN, INT32_MAX, -129, -128, 127, 128, 255, 256, -32769, -32768, 32767, 32768, 65535, 65536, } );
+        s64.insert( s64.begin(), { INT64_MIN, INT64_MAX, -1, 0, 4294967295LL, 4294967296LL, } );
+        f32.insert( f32.begin(), { -FLT_MAX, FLT_MAX, fnan, 7.9f, -7.9f, -128.5f, 127.5f, 255.5f, -32768.5f, 32767.5f, 65535.5f, 2147483648.f, -2147483904.f, std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), } );
+        f64.insert( f64.begin(), { -DBL_MAX, DBL_MAX, dnan, 1e300, 3.5e38, -3.5e38, 2147483647.5, -2147483648.5, 2147483648., DBL_MIN / 4, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), } );
+
+        EXPECT( first_difference<i16  >( s32, []( i32 const * p, i32 const * q, i16 * o ) { return clamp_convert_range( p, q, o ); },
+                                              [&]( std::size_t k ) { return clamp_cast<i16>( s32[k] ); } ) == "" );
+        EXPECT( first_difference<u16  >( s32, []( i32 const * p, i32 const * q, u16 * o ) { return clamp_convert_range( p, q, o ); },
+                                              [&]( std::size_t k ) { return clamp_cast<u16>( s32[k] ); } ) == "" );
+        EXPECT( first_difference<i8   >( s32, []( i32 const * p, i32 const * q, i8  * o ) { return clamp_convert_range( p, q, o ); },
+                                              [&]( std::size_t k ) { return clamp_cast<i8 >( s32[k] ); } ) == "" );
+        EXPECT( first_difference<u8   >( s32, []( i32 const * p, i32 const * q, u8  * o ) { return clamp_convert_range( p, q, o ); },
+                                              [&]( std::size_t k ) { return clamp_cast<u8 >( s32[k] ); } ) == "" );
+        EXPECT( first_difference<i8   >( s16, []( i16 const * p, i16 const * q, i8  * o ) { return clamp_convert_range( p, q, o ); },
+                                              [&]( std::size_t k ) { return clamp_cast<i8 >( s16[k] ); } ) == "" );
+        EXPECT( first_difference<u8   >( s16, []( i16 const * p, i16 const * q, u8  * o ) { return clamp_convert_range( p, q, o ); },
+                                              [&]( std::size_t k ) { return clamp_cast<u8 >( s16[k] ); } ) == "" );
+        EXPECT( first_difference<u8   >( w16, []( u16 const * p, u16 const * q, u8  * o ) { return clamp_convert_range( p, q, o ); },
+                                              [&]( std::size_t k ) { return clamp_cast<u8 >( w16[k] ); } ) == "" );
+        EXPECT( first_difference<i16  >( f32, []( float const * p, float const * q, i16 * o ) { return clamp_convert_range( p, q, o ); },
+                                              [&]( std::size_t k ) { return clamp_cast<i16>( f32[k] ); } ) == "" );
+        EXPECT( first_difference<u16  >( f32, []( float const * p, float const * q, u16 * o ) { return clamp_convert_range( p, q, o ); },
+                                              [&]( std::size_t k ) { return clamp_cast<u16>( f32[k] ); } ) == "" );
+        EXPECT( first_difference<i8   >( f32, []( float const * p, float const * q, i8  * o ) { return clamp_convert_range( p, q, o ); },
+                                              [&]( std::size_t k ) { return clamp_cast<i8 >( f32[k] ); } ) == "" );
+        EXPECT( first_difference<u8   >( f32, []( float const * p, float const * q, u8  * o ) { return clamp_convert_range( p, q, o ); },
+                                              [&]( std::size_t k ) { return clamp_cast<u8 >( f32[k] ); } ) == "" );
+        EXPECT( first_difference<float>( f64, []( double const * p, double const * q, float * o ) { return clamp_convert_range( p, q, o ); },
+                                              [&]( std::size_t k ) { return clamp_cast<float>( f64[k] ); } ) == "" );
+        EXPECT( first_difference<i32  >( f64, []( double const * p, double const * q, i32 * o ) { return clamp_convert_range( p, q, o ); },
+                                              [&]( std::size_t k ) { return clamp_cast<i32>( f64[k] ); } ) == "" );
+        EXPECT( first_difference<u32  >( s64, []( i64 const * p, i64 const * q, u32 * o ) { return clamp_convert_range( p, q, o ); },
+                                              [&]( std::size_t k ) { return clamp_cast<u32>( s64[k] ); } ) == "" );
+    },
+
+    CASE( "clamp_convert_range<To>() converts to a given type via an output iterator" )
+    {
+        std::vector<int>          const a{ -7, 100, 300, };
+        std::vector<std::uint8_t> const b{  0, 100, 255, };
+        std::vector<std::uint8_t> c;
+
+        clamp_convert_range<std::uint8_t>( a.begin(), a.end(), std::back_inserter( c ) );
+
+        EXPECT( c == b );
+    },
+
+    CASE( "clamp_convert_range() narrows in place" )
+    {
+        std::vector<std::int32_t> a( 100 );
+        std::iota( a.begin(), a.end(), 200 );
+
+        std::uint8_t * const out = reinterpret_cast<std::uint8_t *>( a.data() );
+        clamp_convert_range( a.data(), a.data() + a.size(), out );
+
+        for ( int i = 0; i < 100; ++i )
+            EXPECT( ( out[i] == std::uint8_t( std::min( 200 + i, 255 ) ) ) );
+    },
+
+    // clamp_stream( in, out, lo, hi[, pred[, chunk_size]] ):
+
+    CASE( "clamp_stream() clamps a binary stream in chunks" )
+    {
+        std::vector<int> a( 1000 );
+        std::iota( a.begin(), a.end(), -500 );
+
+        std::vector<int> b( a.size() );
+        clamp_range( a.begin(), a.end(), b.begin(), -7, 300 );
+
+        for ( std::size_t chunk : { std::size_t(1), std::size_t(3), std::size_t(999), std::size_t(1000), std::size_t(4096) } )
+        {
+            std::istringstream in( to_bytes( a ) );
+            std::ostringstream out;
+
+            EXPECT( 1000U == clamp_stream( in, out, -7, 300, std14::less<>(), chunk ) );
+            EXPECT( from_bytes<int>( out.str() ) == b );
+        }
+    },
+
+    CASE( "clamp_stream() clamps a binary stream per predicate" )
+    {
+        std::vector<double>       a{ -7,1,2,3,4,5,6,7,8,9, };
+        std::vector<double> const b{  3,3,3,3,4,5,6,7,7,7, };
+
+        std::istringstream in( to_bytes( a ) );
+        std::ostringstream out;
+
+        EXPECT( 10U == clamp_stream( in, out, 7., 3., std14::greater<>(), 4 ) );
+        EXPECT( from_bytes<double>( out.str() ) == b );
+    },
+
+    CASE( "clamp_stream() copies trailing bytes of an incomplete value and handles an empty stream" )
+    {
+        std::vector<std::int16_t> a{ -7, 1, 9, };
+
+        std::istringstream in( to_bytes( a ) + "x" );
+        std::ostringstream out;
+
+        EXPECT( 3U == clamp_stream<std::int16_t>( in, out, 0, 5, std14::less<>(), 2 ) );
+        EXPECT( out.str() == to_bytes( std::vector<std::int16_t>{ 0, 1, 5, } ) + "x" );
+
+        std::istringstream empty;
+        std::ostringstream none;
+
+        EXPECT( 0U == clamp_stream<std::int16_t>( empty, none, 0, 5 ) );
+        EXPECT( none.str().empty() );
+    },
+
+    CASE( "clamp_stream() stops at a failing output and passes on an exception of the input" )
+    {
+        std::vector<int> const a( 1000, 7 );
+        std::vector<int> const b(  300, 7 );
+
+        std::istringstream in( to_bytes( a ) );
+        std::ostringstream out;
+        out.setstate( std::ios_base::badbit );
+
+        EXPECT( 0U == clamp_stream( in, out, 0, 5, std14::less<>(), 3 ) );
+
+        failing_buf buf( to_bytes( b ) );
+        std::istream bad( &buf );
+        std::ostringstream some;
+        bad.exceptions( std::ios_base::badbit );
+
+        EXPECT_THROWS( clamp_stream( bad, some, 0, 5, std14::less<>(), 3 ) );
+        EXPECT( some.str() == to_bytes( std::vector<int>( 300, 5 ) ) );
+    },
+
+    // clamp_range_each( first, last, out, lo, hi[, pred] ):
+
+    CASE( "clamp_range_each() clamps to per-element bounds" )
+    {
+        std::vector<int>       a { -7,1,2,3,4,5,6,7,8,9, };
+        std::vector<int> const lo{  0,2,2,4,0,6,0,0,9,0, };
+        std::vector<int> const hi{  1,3,9,5,1,9,5,7,9,8, };
+        std::vector<int> const b {  0,2,2,4,1,6,5,7,9,8, };
+
+        auto out = clamp_range_each( a.begin(), a.end(), a.begin(), lo.begin(), hi.begin() );
+
+        EXPECT( ( out == a.end() ) );
+        EXPECT(     a == b         );
+    },
+
+    CASE( "clamp_range_each() broadcasts a value bound" )
+    {
+        std::list<int>   const a { -7,1,2,3,4,5,6,7,8,9, };
+        std::vector<int> const hi{  3,3,9,5,2,9,5,7,9,8, };
+        std::vector<int> const b {  2,2,2,3,2,5,5,7,8,8, };
+        std::vector<int> c;
+
+        clamp_range_each( a.begin(), a.end(), std::back_inserter( c ), 2, hi.begin() );
+
+        EXPECT( c == b );
+    },
+
+    CASE( "clamp_range_each() on contiguous arithmetic data agrees with clamp() for all lengths" )
+    {
+        typedef std::int8_t i8; typedef std::uint16_t u16; typedef std::int32_t i32; typedef std::uint64_t u64;
+
+        std::vector<int> lo, hi;
+        for ( int i = 0; i < 150; ++i )
+        {
+            lo.push_back( ( i * 13 ) % 40 );
+            hi.push_back( ( i * 17 ) % 40 + 40 );
+        }
+
+        auto const a = test_values<i8 >( 150 );
+        auto const b = test_values<u16>( 100 );
+        auto const c = test_values<i32>(  50 );
+        auto const d = test_values<u64>(  50 );
+        auto const x = test_values<float >( 50 );
+        auto const y = test_values<double>( 50 );
+
+        std::vector<i8 > const a_lo( lo.begin(), lo.end() ), a_hi( hi.begin(), hi.end() );
+        std::vector<u16> const b_lo( lo.begin(), lo.end() ), b_hi( hi.begin(), hi.end() );
+        std::vector<i32> const c_lo( lo.begin(), lo.end() ), c_hi( hi.begin(), hi.end() );
+        std::vector<u64> const d_lo( lo.begin(), lo.end() ), d_hi( hi.begin(), hi.end() );
+        std::vector<float > const x_lo( lo.begin(), lo.end() ), x_hi( hi.begin(), hi.end() );
+        std::vector<double> const y_lo( lo.begin(), lo.end() ), y_hi( hi.begin(), hi.end() );
+
+        EXPECT( first_difference<i8 >( a, [&]( i8  const * p, i8  const * q, i8  * o ) { return clamp_range_each( p, q, o, a_lo.data(), a_hi.begin() ); },
+                                          [&]( std::size_t k ) { return clamp( a[k], a_lo[k], a_hi[k] ); } ) == "" );
+        EXPECT( first_difference<u16>( b, [&]( u16 const * p, u16 const * q, u16 * o ) { return clamp_range_each( p, q, o, b_lo.data(), b_hi.data()  ); },
+                                          [&]( std::size_t k ) { return clamp( b[k], b_lo[k], b_hi[k] ); } ) == "" );
+        EXPECT( first_difference<i32>( c, [&]( i32 const * p, i32 const * q, i32 * o ) { return clamp_range_each( p, q, o, c_lo.data(), c_hi.data()  ); },
+                                          [&]( std::size_t k ) { return clamp( c[k], c_lo[k], c_hi[k] ); } ) == "" );
+        EXPECT( first_difference<u64>( d, [&]( u64 const * p, u64 const * q, u64 * o ) { return clamp_range_each( p, q, o, d_lo.data(), d_hi.data()  ); },
+                                          [&]( std::size_t k ) { return clamp( d[k], d_lo[k], d_hi[k] ); } ) == "" );
+        EXPECT( first_difference<float >( x, [&]( float  const * p, float  const * q, float  * o ) { return clamp_range_each( p, q, o, x_lo.begin(), x_hi.data() ); },
+                                             [&]( std::size_t k ) { return clamp( x[k], x_lo[k], x_hi[k] ); } ) == "" );
+        EXPECT( first_difference<double>( y, [&]( double const * p, double const * q, double * o ) { return clamp_range_each( p, q, o, y_lo.data(), y_hi.data() ); },
+                                             [&]( std::size_t k ) { return clamp( y[k], y_lo[k], y_hi[k] ); } ) == "" );
+
+        EXPECT( first_difference<i8 >( a, [&]( i8  const * p, i8  const * q, i8  * o ) { return clamp_range_each( p, q, o, a_lo.data(), i8 ( 60 ) ); },
+                                          [&]( std::size_t k ) { return clamp( a[k], a_lo[k], i8 ( 60 ) ); } ) == "" );
+        EXPECT( first_difference<float >( x, [&]( float  const * p, float  const * q, float  * o ) { return clamp_range_each( p, q, o, 20.f, x_hi.data() ); },
+                                             [&]( std::size_t k ) { return clamp( x[k], 20.f, x_hi[k] ); } ) == "" );
+
+        EXPECT( first_difference<i32>( c, [&]( i32 const * p, i32 const * q, i32 * o ) { return clamp_range_each( p, q, o, c_hi.data(), c_lo.data(), std14::greater<>() ); },
+                                          [&]( std::size_t k ) { return clamp( c[k], c_hi[k], c_lo[k], std14::greater<>() ); } ) == "" );
+        EXPECT( first_difference<float >( x, [&]( float  const * p, float  const * q, float  * o ) { return clamp_range_each( p, q, o, x_hi.data(), x_lo.data(), std14::greater<>() ); },
+                                             [&]( std::size_t k ) { return clamp( x[k], x_hi[k], x_lo[k], std14::greater<>() ); } ) == "" );
+    },
+
+    // clamp_range_count( first, last, out, lo, hi[, pred] ):
+
+    CASE( "clamp_range_count() clamps range and counts values below and above" )
+    {
+        std::vector<int>       a{ -7,1,2,3,4,5,6,7,8,9, };
+        std::vector<int> const b{  3,3,3,3,4,5,6,7,7,7, };
+
+        auto const result = clamp_range_count( a.begin(), a.end(), a.begin(), 3, 7 );
+
+        EXPECT( ( result.out == a.end() ) );
+        EXPECT( result.below == 3U );
+        EXPECT( result.above == 2U );
+        EXPECT( a == b );
+    },
+
+    CASE( "clamp_range_count() with non-contiguous iterators and a predicate" )
+    {
+        std::list<int> const a{ -7,1,2,3,4,5,6,7,8,9, };
+        std::vector<int> const b{ 3,3,3,3,4,5,6,7,7,7, };
+        std::vector<int> c;
+
+        auto const result = clamp_range_count( a.begin(), a.end(), std::back_inserter( c ), 7, 3, std14::greater<>() );
+
+        EXPECT( result.below == 2U );
+        EXPECT( result.above == 3U );
+        EXPECT( c == b );
+    },
+
+    CASE( "clamp_range_count() on contiguous arithmetic data clamps like clamp() for all lengths" )
+    {
+        typedef std::int8_t i8; typedef std::uint8_t u8; typedef std::int16_t i16; typedef std::uint32_t u32; typedef std::int64_t i64;
+
+        auto const a = test_values<i8 >( 150 );
+        auto const b = test_values<u8 >( 150 );
+        auto const c = test_values<i16>( 100 );
+        auto const d = test_values<u32>(  50 );
+        auto const e = test_values<i64>(  50 );
+        auto const x = test_values<float >( 50 );
+        auto const y = test_values<double>( 50 );
+
+        EXPECT( first_difference<i8 >( a, []( i8  const * p, i8  const * q, i8  * o ) { return clamp_range_count( p, q, o, i8 (20), i8 (70) ).out; },
+                                          [&]( std::size_t k ) { return clamp( a[k], i8 (20), i8 (70) ); } ) == "" );
+        EXPECT( first_difference<u8 >( b, []( u8  const * p, u8  const * q, u8  * o ) { return clamp_range_count( p, q, o, u8 (20), u8 (70) ).out; },
+                                          [&]( std::size_t k ) { return clamp( b[k], u8 (20), u8 (70) ); } ) == "" );
+        EXPECT( first_difference<i16>( c, []( i16 const * p, i16 const * q, i16 * o ) { return clamp_range_count( p, q, o, i16(50), i16(50) ).out; },
+                                          [&]( std::size_t k ) { return clamp( c[k], i16(50), i16(50) ); } ) == "" );
+        EXPECT( first_difference<u32>( d, []( u32 const * p, u32 const * q, u32 * o ) { return clamp_range_count( p, q, o, u32(20), u32(70) ).out; },
+                                          [&]( std::size_t k ) { return clamp( d[k], u32(20), u32(70) ); } ) == "" );
+        EXPECT( first_difference<i64>( e, []( i64 const * p, i64 const * q, i64 * o ) { return clamp_range_count( p, q, o, i64(20), i64(70) ).out; },
+                                          [&]( std::size_t k ) { return clamp( e[k], i64(20), i64(70) ); } ) == "" );
+        EXPECT( first_difference<float >( x, []( float  const * p, float  const * q, float  * o ) { return clamp_range_count( p, q, o, 70.f, 20.f, std14::greater<>() ).out; },
+                                             [&]( std::size_t k ) { return clamp( x[k], 70.f, 20.f, std14::greater<>() ); } ) == "" );
+        EXPECT( first_difference<double>( y, []( double const * p, double const * q, double * o ) { return clamp_range_count( p, q, o, 20. , 70.  ).out; },
+                                             [&]( std::size_t k ) { return clamp( y[k], 20. , 70.  ); } ) == "" );
+    },
+
+    CASE( "clamp_range_count() on contiguous arithmetic data counts beyond the range of a counter per SIMD lane" )
+    {
+        std::vector<std::int8_t> a( 3 * 100000 + 2 );
+        std::vector<std::uint16_t> b( a.size() );
+        std::vector<float> x( a.size() );
+        std::vector<double> y( 17 );
+
+        for ( std::size_t i = 0; i < a.size(); ++i )
+        {
+            a[i] = static_cast<std::int8_t>( i % 3 == 0 ? -100 : i % 3 == 1 ? 0 : 100 );
+            b[i] = static_cast<std::uint16_t>( i % 3 == 0 ? 0 : i % 3 == 1 ? 1000 : 65535 );
+            x[i] = i % 3 == 0 ? -1e30f : i % 3 == 1 ? 0.f : 1e30f;
+        }
+        for ( std::size_t i = 0; i < y.size(); ++i )
+            y[i] = i % 3 == 0 ? -1. : i % 3 == 1 ? 0. : 1.;
+
+        auto const ra = clamp_range_count( a.begin(), a.end(), a.begin(), std::int8_t( -1 ), std::int8_t( 1 ) );
+        auto const rb = clamp_range_count( b.begin(), b.end(), b.begin(), std::uint16_t( 1 ), std::uint16_t( 65534 ) );
+        auto const rx = clamp_range_count( x.begin(), x.end(), x.begin(), 1.f, -1.f, std14::greater<>() );
+        auto const ry = clamp_range_count( y.begin(), y.end(), y.begin(), -.5, .5 );
+
+        EXPECT( ra.below == 100001U ); EXPECT( ra.above == 100000U );
+        EXPECT( rb.below == 100001U ); EXPECT( rb.above == 100000U );
+        EXPECT( rx.below == 100000U ); EXPECT( rx.above == 100001U );
+        EXPECT( ry.below ==      6U ); EXPECT( ry.above ==      5U );
+        EXPECT( a[0] == -1 ); EXPECT( a[300000] == -1 ); EXPECT( a[300001] == 0 );
+        EXPECT( b[0] ==  1 ); EXPECT( b[300001] == 1000 ); EXPECT( b[299999] == 65534 );
+    },
+
+    CASE( "clamp_range_count() does not count NaN" )
+    {
+        std::vector<float> a( 37, 9.f );
+        a[3] = a[36] = std::numeric_limits<float>::quiet_NaN();
+
+        auto const result = clamp_range_count( a.begin(), a.end(), a.begin(), 3.f, 7.f );
+
+        EXPECT( result.below ==  0U );
+        EXPECT( result.above == 35U );
+    },
+
+    // clamp_reduce( first, last, lo, hi, init, op[, pred] ), clamp_sum() etc.:
+
+    CASE( "clamp_reduce() reduces clamped values with a user-supplied operation" )
+    {
+        std::list<int> const a{ -7,1,2,3,4,5,6,7,8,9, };
+
+        EXPECT( ( 3*3*3*3*4*5*6*7*7*7 ) == clamp_reduce( a.begin(), a.end(), 3, 7, 1, std::multiplies<int>() ) );
+        EXPECT( ( 3*3*3*3*4*5*6*7*7*7 ) == clamp_reduce( a.begin(), a.end(), 7, 3, 1, std::multiplies<int>(), std14::greater<>() ) );
+        EXPECT( "3333456777" == clamp_reduce( a.begin(), a.end(), 3, 7, std::string(),
+            []( std::string s, int x ) { return s + char( '0' + x ); } ) );
+    },
+
+    CASE( "clamp_sum(), clamp_mean(), clamp_min() and clamp_max() reduce clamped values" )
+    {
+        std::vector<int>    const a{ -7,1,2,3,4,5,6,7,8,9, };
+        std::list<double>   const l{ -7,1,2,3,4,5,6,7,8,9, };
+        std::vector<std::uint8_t> const u( 1000, 255 );
+
+        EXPECT( 48 == clamp_sum( a.begin(), a.end(), 3, 7 ) );
+        EXPECT( 48 == clamp_sum( a.begin(), a.end(), 7, 3, std14::greater<>() ) );
+        EXPECT( 48 == clamp_sum( l.begin(), l.end(), 3., 7. ) );
+        EXPECT( 255000U == clamp_sum( u.begin(), u.end(), std::uint8_t(0), std::uint8_t(255) ) );
+
+        EXPECT( 4.8 == clamp_mean( a.begin(), a.end(), 3, 7 ) );
+        EXPECT( 4.8 == clamp_mean( l.begin(), l.end(), 3., 7. ) );
+        EXPECT( clamp_mean( a.begin(), a.begin(), 3, 7 ) != clamp_mean( a.begin(), a.begin(), 3, 7 ) );
+
+        std::istringstream in( "1 5 9 20" ), in_par( "1 5 9 20" ), none( "" );
+
+        EXPECT( 6.5 == clamp_mean( std::istream_iterator<int>( in ), std::istream_iterator<int>(), 2, 10 ) );
+        EXPECT( 6.5 == clamp_mean( clamp_execution::par, std::istream_iterator<int>( in_par ), std::istream_iterator<int>(), 2, 10 ) );
+        EXPECT( 4.8 == clamp_mean( clamp_execution::par, l.begin(), l.end(), 3., 7. ) );
+        EXPECT( std::isnan( clamp_mean( std::istream_iterator<int>( none ), std::istream_iterator<int>(), 2, 10 ) ) );
+
+        EXPECT( 3 == clamp_min( a.begin(), a.end(), 3, 7 ) );
+        EXPECT( 7 == clamp_max( a.begin(), a.end(), 3, 7 ) );
+        EXPECT( 7 == clamp_min( a.begin(), a.end(), 7, 3, std14::greater<>() ) );
+        EXPECT( 3 == clamp_max( a.begin(), a.end(), 7, 3, std14::greater<>() ) );
+        EXPECT( 5 == clamp_min( a.begin() + 5, a.end(), 3, 7 ) );
+    },
+
+    CASE( "clamp_sum() on contiguous arithmetic data sums the clamped values for all lengths" )
+    {
+        auto const a = test_values<std::int8_t  >( 150 );
+        auto const b = test_values<std::uint16_t>( 100 );
+        auto const c = test_values<std::int32_t >(  50 );
+        auto const d = test_values<std::uint64_t>(  50 );
+        auto const x = test_values<float        >(  50 );
+        auto const y = test_values<double       >(  50 );
+
+        long long sa = 0, sc = 0; unsigned long long sb = 0, sd = 0; double sx = 0, sy = 0;
+
+        for ( std::size_t n = 0; n <= a.size(); ++n )
+        {
+            EXPECT( clamp_sum( a.begin(), a.begin() + n, std::int8_t( 20 ), std::int8_t( 70 ) ) == sa );
+
+            if ( n < a.size() )
+                sa += clamp( a[n], std::int8_t( 20 ), std::int8_t( 70 ) );
+        }
+
+        for ( std::size_t n = 0; n <= b.size(); ++n )
+        {
+            EXPECT( clamp_sum( b.begin(), b.begin() + n, std::uint16_t( 20 ), std::uint16_t( 70 ) ) == sb );
+
+            if ( n < b.size() )
+                sb += clamp( b[n], std::uint16_t( 20 ), std::uint16_t( 70 ) );
+        }
+
+        for ( std::size_t n = 0; n <= c.size(); ++n )
+        {
+            EXPECT( clamp_sum( c.begin(), c.begin() + n, 70, 20, std14::greater<>() ) == sc );
+
+            if ( n < c.size() )
+                sc += clamp( c[n], 70, 20, std14::greater<>() );
+        }
+
+        for ( std::size_t n = 0; n <= d.size(); ++n )
+        {
+            EXPECT( clamp_sum( d.begin(), d.begin() + n, std::uint64_t( 20 ), std::uint64_t( 70 ) ) == sd );
+
+            if ( n < d.size() )
+                sd += clamp( d[n], std::uint64_t( 20 ), std::uint64_t( 70 ) );
+        }
+
+        for ( std::size_t n = 0; n <= x.size(); ++n )
+        {
+            EXPECT( clamp_sum( x.begin(), x.begin() + n, 20.f, 70.f ) == sx );
+
+            if ( n < x.size() )
+                sx += clamp( x[n], 20.f, 70.f );
+        }
+
+        for ( std::size_t n = 0; n <= y.size(); ++n )
+        {
+            EXPECT( clamp_sum( y.begin(), y.begin() + n, 20., 70. ) == sy );
+
+            if ( n < y.size() )
+                sy += clamp( y[n], 20., 70. );
+        }
+    },
+
+    CASE( "clamp_sum() on contiguous arithmetic data does not overflow the SIMD accumulators" )
+    {
+        std::vector<std::int8_t>  const a( 100003, 127 );
+        std::vector<std::int16_t> const b( 100003, -32768 );
+        std::vector<std::int32_t> const c( 100003, INT32_MAX );
+
+        EXPECT( clamp_sum( a.begin(), a.end(), std::int8_t( 0 ), std::int8_t( 127 ) ) == 127LL * 100003 );
+        EXPECT( clamp_sum( b.begin(), b.end(), std::int16_t( -32768 ), std::int16_t( 0 ) ) == -32768LL * 100003 );
+        EXPECT( clamp_sum( c.begin(), c.end(), 0, INT32_MAX ) == 2147483647LL * 100003 );
+    },
+
+    CASE( "clamp_sum(policy,...) and clamp_mean(policy,...) reduce a large range like clamp_sum()" )
+    {
+        std::vector<int> a( 3 * CLAMP_PARALLEL_THRESHOLD + 17 );
+        std::iota( a.begin(), a.end(), -1000 );
+
+        int const lo = 10, hi = int( a.size() / 2 );
+
+        long long const expect = clamp_sum( a.begin(), a.end(), lo, hi );
+
+        EXPECT( expect == clamp_sum( clamp_execution::seq      , a.begin(), a.end(), lo, hi ) );
+        EXPECT( expect == clamp_sum( clamp_execution::par      , a.begin(), a.end(), lo, hi ) );
+        EXPECT( expect == clamp_sum( clamp_execution::par_unseq, a.begin(), a.end(), lo, hi ) );
+        EXPECT( expect == clamp_sum( clamp_execution::par      , a.begin(), a.end(), hi, lo, std14::greater<>() ) );
+
+        EXPECT( clamp_mean( a.begin(), a.end(), lo, hi ) == clamp_mean( clamp_execution::par, a.begin(), a.end(), lo, hi ) );
+    },
+
+    // clamp_range_channels( first, last, out, lo, hi[, pred] ):
+
+    CASE( "clamp_range_channels() clamps interleaved channels to bounds per channel" )
+    {
+        typedef std::array<int, 3> xyz;
+
+        std::vector<int>       a{ -7,1,2, 3,4,5, 6,7,8, 9,10,11, };
+        std::vector<int> const b{  0,1,5, 3,4,5, 3,7,8, 3, 9,10, };
+        std::list  <int>       l( a.begin(), a.end() );
+        std::list  <int> const c( b.begin(), b.end() );
+
+        EXPECT( ( clamp_range_channels( a.begin(), a.end(), a.begin(), xyz{ 0, 1, 5 }, xyz{ 3, 9, 10 } ) == a.end() ) );
+        EXPECT( ( clamp_range_channels( l.begin(), l.end(), l.begin(), xyz{ 3, 9, 10 }, xyz{ 0, 1, 5 }, std14::greater<>() ) == l.end() ) );
+
+        EXPECT( a == b );
+        EXPECT( ( l == c ) );
+    },
+
+    CASE( "clamp_range_channels() on contiguous arithmetic data agrees with clamp() per channel for all lengths" )
+    {
+        typedef std::int8_t i8; typedef std::uint8_t u8; typedef std::int16_t i16; typedef std::uint16_t u16;
+        typedef std::int32_t i32; typedef std::int64_t i64;
+
+        auto const a = test_values<u8 >( 300 );
+        auto const b = test_values<i8 >( 300 );
+        auto const c = test_values<i16>( 150 );
+        auto const d = test_values<u16>( 150 );
+        auto const e = test_values<i32>( 100 );
+        auto const g = test_values<i64>( 100 );
+        auto const x = test_values<float >( 100 );
+        auto const y = test_values<double>( 100 );
+
+        std::array<u8 , 4> const a_lo{ 0, 10, 20, 30, },  a_hi{ 50, 60, 70, 80, };
+        std::array<u8 , 3> const a3_lo{ 0, 10, 20, },     a3_hi{ 50, 60, 70, };
+        std::array<i8 , 2> const b_lo{ -50, 10, },        b_hi{ 0, 60, };
+        std::array<i16, 3> const c_lo{ -50, 10, 20, },    c_hi{ 0, 60, 70, };
+        std::array<u16, 4> const d_lo{ 0, 10, 20, 30, },  d_hi{ 50, 60, 70, 80, };
+        std::array<i32, 3> const e_lo{ -50, 10, 20, },    e_hi{ 0, 60, 70, };
+        std::array<i64, 2> const g_lo{ -50, 10, },        g_hi{ 0, 60, };
+        std::array<float , 3> const x_lo{ -50, 10, 20, }, x_hi{ 0, 60, 70, };
+        std::array<float , 4> const x4_lo{ 0, 10, 20, 30, }, x4_hi{ 50, 60, 70, 80, };
+        std::array<double, 3> const y_lo{ -50, 10, 20, }, y_hi{ 0, 60, 70, };
+        std::array<double, 5> const y5_lo{ -50, -40, -30, -20, -10, }, y5_hi{ 0, 10, 20, 30, 40, };
+
+        EXPECT( first_difference<u8 >( a, [&]( u8  const * p, u8  const * q, u8  * o ) { return clamp_range_channels( p, q, o, a_lo , a_hi  ); },
+                                          [&]( std::size_t k ) { return clamp( a[k], a_lo [k % 4], a_hi [k % 4] ); } ) == "" );
+        EXPECT( first_difference<u8 >( a, [&]( u8  const * p, u8  const * q, u8  * o ) { return clamp_range_channels( p, q, o, a3_lo, a3_hi ); },
+                                          [&]( std::size_t k ) { return clamp( a[k], a3_lo[k % 3], a3_hi[k % 3] ); } ) == "" );
+        EXPECT( first_difference<i8 >( b, [&]( i8  const * p, i8  const * q, i8  * o ) { return clamp_range_channels( p, q, o, b_lo , b_hi  ); },
+                                          [&]( std::size_t k ) { return clamp( b[k], b_lo [k % 2], b_hi [k % 2] ); } ) == "" );
+        EXPECT( first_difference<i16>( c, [&]( i16 const * p, i16 const * q, i16 * o ) { return clamp_range_channels( p, q, o, c_lo , c_hi  ); },
+                                          [&]( std::size_t k ) { return clamp( c[k], c_lo [k % 3], c_hi [k % 3] ); } ) == "" );
+        EXPECT( first_difference<u16>( d, [&]( u16 const * p, u16 const * q, u16 * o ) { return clamp_range_channels( p, q, o, d_lo , d_hi  ); },
+                                          [&]( std::size_t k ) { return clamp( d[k], d_lo [k % 4], d_hi [k % 4] ); } ) == "" );
+        EXPECT( first_difference<i32>( e, [&]( i32 const * p, i32 const * q, i32 * o ) { return clamp_range_channels( p, q, o, e_lo , e_hi  ); },
+                                          [&]( std::size_t k ) { return clamp( e[k], e_lo [k % 3], e_hi [k % 3] ); } ) == "" );
+        EXPECT( first_difference<i64>( g, [&]( i64 const * p, i64 const * q, i64 * o ) { return clamp_range_channels( p, q, o, g_lo , g_hi  ); },
+                                          [&]( std::size_t k ) { return clamp( g[k], g_lo [k % 2], g_hi [k % 2] ); } ) == "" );
+        EXPECT( first_difference<float >( x, [&]( float  const * p, float  const * q, float  * o ) { return clamp_range_channels( p, q, o, x_lo, x_hi ); },
+                                             [&]( std::size_t k ) { return clamp( x[k], x_lo[k % 3], x_hi[k % 3] ); } ) == "" );
+        EXPECT( first_difference<double>( y, [&]( double const * p, double const * q, double * o ) { return clamp_range_channels( p, q, o, y_lo, y_hi ); },
+                                             [&]( std::size_t k ) { return clamp( y[k], y_lo[k % 3], y_hi[k % 3] ); } ) == "" );
+        EXPECT( first_difference<double>( y, [&]( double const * p, double const * q, double * o ) { return clamp_range_channels( p, q, o, y5_lo, y5_hi ); },
+                                             [&]( std::size_t k ) { return clamp( y[k], y5_lo[k % 5], y5_hi[k % 5] ); } ) == "" );
+
+        EXPECT( first_difference<float >( x, [&]( float  const * p, float  const * q, float  * o ) { return clamp_range_channels( p, q, o, x4_hi, x4_lo, std14::greater<>() ); },
+                                             [&]( std::size_t k ) { return clamp( x[k], x4_hi[k % 4], x4_lo[k % 4], std14::greater<>() ); } ) == "" );
+    },
+
+    // clamp_range_2d( [policy,] in, out, lo, hi[, pred] ):
+
+    CASE( "clamp_range_2d() clamps a region of interest in place and to a region with another pitch" )
+    {
+        std::vector<int> image( 6 * 5 );
+        std::iota( image.begin(), image.end(), 0 );
+
+        std::vector<int> const expect{
+             0, 1, 2, 3, 4, 5,
+             6, 9, 9, 9,10,11,
+            12,13,14,15,16,17,
+            18,19,19,19,22,23,
+            24,25,26,27,28,29, };
+
+        std::vector<int> copy( 4 * 3, -1 );
+        std::vector<int> const expect_copy{ 9,9,9,-1, 13,14,15,-1, 19,19,19,-1, };
+
+        auto const roi = make_pitched_view( image.data() + 7, 3, 3, 6 * sizeof(int) );
+
+        clamp_range_2d( roi, make_pitched_view( copy.data(), 3, 3, 4 * sizeof(int) ), 9, 19 );
+        clamp_range_2d( roi, roi, 9, 19 );
+
+        EXPECT( image == expect );
+        EXPECT( copy == expect_copy );
+    },
+
+    CASE( "clamp_range_2d() clamps strided elements per predicate" )
+    {
+        std::vector<double> image( 4 * 3 );
+        std::iota( image.begin(), image.end(), 0 );
+
+        std::vector<double> const expect{
+             3, 1, 3, 3,
+             4, 5, 6, 7,
+             8, 9, 8,11, };
+
+        auto const even = make_pitched_view( image.data(), 2, 2, 8 * sizeof(double), 2 );
+
+        clamp_range_2d( even, even, 8., 3., std14::greater<>() );
+
+        EXPECT( image == expect );
+    },
+
+    CASE( "clamp_range_2d(policy,...) clamps a large region like clamp_range_2d()" )
+    {
+        std::size_t const width = 1000, height = CLAMP_PARALLEL_THRESHOLD / 250, pitch = 1024;
+
+        std::vector<float> image( pitch * height );
+        std::iota( image.begin(), image.end(), -1000.f );
+
+        std::vector<float> seq( image ), par( image ), par_unseq( image );
+
+        auto const in        = make_pitched_view( image.data()    , width, height, pitch * sizeof(float) );
+        auto const out       = make_pitched_view( seq.data()      , width, height, pitch * sizeof(float) );
+        auto const out_par   = make_pitched_view( par.data()      , width, height, pitch * sizeof(float) );
+        auto const out_unseq = make_pitched_view( par_unseq.data(), width, height, pitch * sizeof(float) );
+
+        clamp_range_2d( in, out, 0.f, 1e5f );
+        clamp_range_2d( clamp_execution::par      , in, out_par  , 0.f, 1e5f );
+        clamp_range_2d( clamp_execution::par_unseq, in, out_unseq, 0.f, 1e5f );
+
+        EXPECT( par       == seq );
+        EXPECT( par_unseq == seq );
+    },
+
+    // clamp_half, clamp_bfloat16:
+
+    CASE( "clamp_half converts to and from float, rounding to nearest even" )
+    {
+        EXPECT( clamp_half( 1.f ).bits == 0x3c00 );
+        EXPECT( clamp_half( -2.f ).bits == 0xc000 );
+        EXPECT( clamp_half( -0.f ).bits == 0x8000 );
+        EXPECT( clamp_half( 65504.f ).bits == 0x7bff );
+        EXPECT( clamp_half( 65519.f ).bits == 0x7bff );
+        EXPECT( clamp_half( 65520.f ).bits == 0x7c00 );
+        EXPECT( clamp_half( -1e10f ).bits == 0xfc00 );
+        EXPECT( clamp_half( 1.f + 1.f / 2048 ).bits == 0x3c00 );
+        EXPECT( clamp_half( 1.f + 3.f / 2048 ).bits == 0x3c02 );
+        EXPECT( clamp_half( std::ldexp( 1.f, -24 ) ).bits == 0x0001 );
+        EXPECT( clamp_half( std::ldexp( 1.f, -25 ) ).bits == 0x0000 );
+        EXPECT( clamp_half( std::ldexp( 3.f, -25 ) ).bits == 0x0002 );
+        EXPECT( ( clamp_half( std::numeric_limits<float>::quiet_NaN() ).bits & 0x7e00 ) == 0x7e00 );
+
+        for ( unsigned bits = 0; bits <= 0xffff; ++bits )
+        {
+            clamp_half const h = clamp_half::from_bits( static_cast<std::uint16_t>( bits ) );
+            if ( h == h && clamp_half( float( h ) ).bits != h.bits )
+                EXPECT( bits == 0U );
+        }
+    },
+
+    CASE( "clamp_bfloat16 converts to and from float, rounding to nearest even" )
+    {
+        EXPECT( clamp_bfloat16( 1.f ).bits == 0x3f80 );
+        EXPECT( clamp_bfloat16( -0.f ).bits == 0x8000 );
+        EXPECT( clamp_bfloat16( 1.f + 1.f / 256 ).bits == 0x3f80 );
+        EXPECT( clamp_bfloat16( 1.f + 3.f / 256 ).bits == 0x3f82 );
+        EXPECT( float( clamp_bfloat16::from_bits( 0x4049 ) ) == 3.140625f );
+        EXPECT( ( clamp_bfloat16( std::numeric_limits<float>::quiet_NaN() ).bits & 0x7fc0 ) == 0x7fc0 );
+    },
+
+    CASE( "clamp(v,lo,hi) and clamp_range() clamp clamp_half and clamp_bfloat16 values" )
+    {
+        std::vector<clamp_half> a{ clamp_half( -7.f ), clamp_half( 1.5f ), clamp_half( 9.f ), };
+
+        EXPECT( float( clamp( clamp_half( 9.f ), clamp_half( 0.f ), clamp_half( 2.5f ) ) ) == 2.5f );
+        EXPECT( float( clamp( clamp_bfloat16( -9.f ), clamp_bfloat16( -1.f ), clamp_bfloat16( 1.f ) ) ) == -1.f );
+
+        clamp_range( a.begin(), a.end(), a.begin(), clamp_half( 0.f ), clamp_half( 2.5f ) );
+
+        EXPECT( float( a[0] ) == 0.0f );
+        EXPECT( float( a[1] ) == 1.5f );
+        EXPECT( float( a[2] ) == 2.5f );
+    },
+
+    CASE( "clamp_range() on clamp_half and clamp_bfloat16 data keeps NaN, infinity and -0.0 like clamp()" )
+    {
+        float const inf = std::numeric_limits<float>::infinity();
+
+        std::vector<clamp_half> h( 20, clamp_half( 5.f ) );
+        h[0] = clamp_half( -inf ); h[1] = clamp_half( inf ); h[2] = clamp_half::from_bits( 0x7e00 );
+        h[3] = clamp_half( -0.f ); h[4] = clamp_half::from_bits( 0x0001 ); h[19] = clamp_half::from_bits( 0xfe00 );
+
+        std::vector<clamp_bfloat16> b( 20, clamp_bfloat16( 5.f ) );
+        b[0] = clamp_bfloat16( -inf ); b[1] = clamp_bfloat16( inf ); b[2] = clamp_bfloat16::from_bits( 0x7fc0 );
+        b[3] = clamp_bfloat16( -0.f ); b[19] = clamp_bfloat16::from_bits( 0x8001 );
+
+        clamp_range( h.begin(), h.end(), h.begin(), clamp_half( 0.f ), clamp_half( 1.f ) );
+        clamp_range( b.begin(), b.end(), b.begin(), clamp_bfloat16( -1.f ), clamp_bfloat16( 0.f ) );
+
+        EXPECT( h[0].bits == 0x0000 );
+        EXPECT( h[1].bits == 0x3c00 );
+        EXPECT( h[2] != h[2] );
+        EXPECT( h[3].bits == 0x8000 );
+        EXPECT( h[4].bits == 0x0001 );
+        EXPECT( h[5].bits == 0x3c00 );
+        EXPECT( h[19] != h[19] );
+
+        EXPECT( b[0].bits == 0xbf80 );
+        EXPECT( b[1].bits == 0x0000 );
+        EXPECT( b[2] != b[2] );
+        EXPECT( b[3].bits == 0x8000 );
+        EXPECT( b[5].bits == 0x0000 );
+        EXPECT( b[19].bits == 0x8001 );
+    },
+
+    CASE( "clamp_range() and clamp_range_count() on clamp_half data agree with clamp() for all bit patterns" )
+    {
+        float const inf = std::numeric_limits<float>::infinity();
+
+        std::vector<clamp_half> in( 65536 );
+        for ( std::size_t i = 0; i < in.size(); ++i )
+            in[i] = clamp_half::from_bits( static_cast<std::uint16_t>( i * 40503 ) );
+
+        for ( auto const & bounds : std::vector<std::pair<float, float>>{ { -1.f, 2.f }, { 0.f, 0.f }, { -0.f, 1e-6f }, { -inf, inf }, } )
+        {
+            clamp_half const lo( bounds.first ), hi( bounds.second );
+            std::string const where = "[" + to_text( lo ) + ", " + to_text( hi ) + "]";
+
+            std::vector<clamp_half> out( in.size() ), out_count( in.size() );
+
+            auto const result = clamp_range_count( in.begin(), in.end(), out_count.begin(), lo, hi );
+            clamp_range( in.begin(), in.end(), out.begin(), lo, hi );
+
+            auto const expect = [&]( std::size_t i ) { return clamp( in[i], lo, hi ); };
+
+            EXPECT( difference( where, out      , 0, in.size(), expect ) == "" );
+            EXPECT( difference( where, out_count, 0, in.size(), expect ) == "" );
+            EXPECT( result.below == std::size_t( std::count_if( in.begin(), in.end(), [&]( clamp_half x ) { return x < lo; } ) ) );
+            EXPECT( result.above == std::size_t( std::count_if( in.begin(), in.end(), [&]( clamp_half x ) { return hi < x; } ) ) );
+        }
+    },
+
+    CASE( "clamp_range() and clamp_range_count() on clamp_bfloat16 data agree with clamp() for all bit patterns" )
+    {
+        float const inf = std::numeric_limits<float>::infinity();
+
+        std::vector<clamp_bfloat16> in( 65536 );
+        for ( std::size_t i = 0; i < in.size(); ++i )
+            in[i] = clamp_bfloat16::from_bits( static_cast<std::uint16_t>( i * 40503 ) );
+
+        for ( auto const & bounds : std::vector<std::pair<float, float>>{ { -1.f, 2.f }, { 0.f, 0.f }, { -1e30f, -1e-30f }, { -inf, inf }, } )
+        {
+            clamp_bfloat16 const lo( bounds.first ), hi( bounds.second );
+            std::string const where = "[" + to_text( lo ) + ", " + to_text( hi ) + "]";
+
+            std::vector<clamp_bfloat16> out( in.size() ), out_count( in.size() );
+
+            auto const result = clamp_range_count( in.begin(), in.end(), out_count.begin(), lo, hi );
+            clamp_range( in.begin(), in.end(), out.begin(), lo, hi );
+
+            auto const expect = [&]( std::size_t i ) { return clamp( in[i], lo, hi ); };
+
+            EXPECT( difference( where, out      , 0, in.size(), expect ) == "" );
+            EXPECT( difference( where, out_count, 0, in.size(), expect ) == "" );
+            EXPECT( result.below == std::size_t( std::count_if( in.begin(), in.end(), [&]( clamp_bfloat16 x ) { return x < lo; } ) ) );
+            EXPECT( result.above == std::size_t( std::count_if( in.begin(), in.end(), [&]( clamp_bfloat16 x ) { return hi < x; } ) ) );
+        }
+    },
+
+    CASE( "clamp_range() on clamp_half and clamp_bfloat16 data agrees with clamp() for all lengths" )
+    {
+        std::vector<clamp_half> h;
+        std::vector<clamp_bfloat16> b;
+        for ( int i = 0; i < 50; ++i )
+        {
+            h.push_back( clamp_half    ::from_bits( static_cast<std::uint16_t>( i * 40503 ) ) );
+            b.push_back( clamp_bfloat16::from_bits( static_cast<std::uint16_t>( i * 40503 ) ) );
+        }
+
+        clamp_half     const h_lo( -1.f ), h_hi( 2.f );
+        clamp_bfloat16 const b_lo( -1.f ), b_hi( 2.f );
+
+        EXPECT( first_difference<clamp_half>( h, [&]( clamp_half const * p, clamp_half const * q, clamp_half * o ) { return clamp_range( p, q, o, h_lo, h_hi ); },
+                                                 [&]( std::size_t k ) { return clamp( h[k], h_lo, h_hi ); } ) == "" );
+        EXPECT( first_difference<clamp_half>( h, [&]( clamp_half const * p, clamp_half const * q, clamp_half * o ) { return clamp_range_count( p, q, o, h_lo, h_hi ).out; },
+                                                 [&]( std::size_t k ) { return clamp( h[k], h_lo, h_hi ); } ) == "" );
+        EXPECT( first_difference<clamp_bfloat16>( b, [&]( clamp_bfloat16 const * p, clamp_bfloat16 const * q, clamp_bfloat16 * o ) { return clamp_range( p, q, o, b_lo, b_hi ); },
+                                                     [&]( std::size_t k ) { return clamp( b[k], b_lo, b_hi ); } ) == "" );
+        EXPECT( first_difference<clamp_bfloat16>( b, [&]( clamp_bfloat16 const * p, clamp_bfloat16 const * q, clamp_bfloat16 * o ) { return clamp_range( p, q, o, b_hi, b_lo, std14::greater<>() ); },
+                                                     [&]( std::size_t k ) { return clamp( b[k], b_hi, b_lo, std14::greater<>() ); } ) == "" );
+    },
+
+    CASE( "clamp_sum() and clamp_mean() sum clamp_half and clamp_bfloat16 values in double" )
+    {
+        std::vector<clamp_half>     h;
+        std::vector<clamp_bfloat16> b;
+        for ( int i = -10; i < 10; ++i )
+        {
+            h.push_back( clamp_half    ( i * 0.5f ) );
+            b.push_back( clamp_bfloat16( i * 0.5f ) );
+        }
+
+        static_assert( std::is_same<double, decltype( clamp_sum( h.begin(), h.end(), h[0], h[0] ) )>::value, "expect double sum" );
+        static_assert( std::is_same<double, decltype( clamp_sum( b.begin(), b.end(), b[0], b[0] ) )>::value, "expect double sum" );
+
+        EXPECT( clamp_sum ( h.begin(), h.end(), clamp_half( -1.f ), clamp_half( 2.f ) ) == 5.5 );
+        EXPECT( clamp_mean( b.begin(), b.end(), clamp_bfloat16( -1.f ), clamp_bfloat16( 2.f ) ) == 5.5 / 20 );
+        EXPECT( clamp_sum ( b.begin(), b.end(), clamp_bfloat16( 2.f ), clamp_bfloat16( -1.f ), std14::greater<>() ) == 5.5 );
+        EXPECT( clamp_sum ( clamp_execution::par, h.data(), h.data() + h.size(), clamp_half( -1.f ), clamp_half( 2.f ) ) == 5.5 );
+    },
+
+    // clamp( nan_policy, v, lo, hi[, pred] ), clamp_range( nan_policy, ... ):
+
+    CASE( "clamp(policy,v,lo,hi) propagates NaN or maps it to lo or hi" )
+    {
+        double const nan = std::numeric_limits<double>::quiet_NaN();
+
+        EXPECT( clamp( clamp_nan::propagate, nan, 3., 7. ) != clamp( clamp_nan::propagate, nan, 3., 7. ) );
+        EXPECT( clamp( clamp_nan::to_lo, nan, 3., 7. ) == 3. );
+        EXPECT( clamp( clamp_nan::to_hi, nan, 3., 7. ) == 7. );
+        EXPECT( clamp( clamp_nan::to_lo, nan, 7., 3., std14::greater<>() ) == 7. );
+        EXPECT( clamp( clamp_nan::to_lo, 9. , 3., 7. ) == 7. );
+        EXPECT( clamp( clamp_nan::assume_none, 1., 3., 7. ) == 3. );
+        EXPECT( clamp( clamp_nan::to_hi, 9, 3, 7 ) == 7 );
+        EXPECT( float( clamp( clamp_nan::to_hi, clamp_half::from_bits( 0x7e00 ), clamp_half( 3.f ), clamp_half( 7.f ) ) ) == 7.f );
+    },
+
+    CASE( "clamp(policy,v,lo,hi) is a valid constexpr expression" )
+    {
+        constexpr auto v = clamp( clamp_nan::to_lo, 9, 3, 7 );
+
+        EXPECT( v == 7 );
+    },
+
+    CASE( "clamp_range(policy,...) on contiguous data agrees with clamp(policy,...) for NaN policies for all lengths" )
+    {
+        typedef clamp_half f16; typedef clamp_bfloat16 bf16;
+
+        std::vector<float> x;
+        std::vector<double> y;
+        std::vector<f16> h;
+        std::vector<bf16> b;
+
+        for ( int i = 0; i < 50; ++i )
+        {
+            float const v = i % 7 == 3 ? std::numeric_limits<float>::quiet_NaN() : float( ( i * 37 ) % 101 );
+
+            x.push_back( v ); y.push_back( v ); h.push_back( f16( v ) ); b.push_back( bf16( v ) );
+        }
+
+        f16  const h_lo( 20.f ), h_hi( 70.f );
+        bf16 const b_lo( 20.f ), b_hi( 70.f );
+
+        EXPECT( first_difference<float >( x, []( float  const * p, float  const * q, float  * o ) { return clamp_range( clamp_nan::to_lo    , p, q, o, 20.f, 70.f ); },
+                                             [&]( std::size_t k ) { return clamp( clamp_nan::to_lo    , x[k], 20.f, 70.f ); } ) == "" );
+        EXPECT( first_difference<float >( x, []( float  const * p, float  const * q, float  * o ) { return clamp_range( clamp_nan::to_hi    , p, q, o, 20.f, 70.f ); },
+                                             [&]( std::size_t k ) { return clamp( clamp_nan::to_hi    , x[k], 20.f, 70.f ); } ) == "" );
+        EXPECT( first_difference<float >( x, []( float  const * p, float  const * q, float  * o ) { return clamp_range( clamp_nan::propagate, p, q, o, 20.f, 70.f ); },
+                                             [&]( std::size_t k ) { return clamp( clamp_nan::propagate, x[k], 20.f, 70.f ); } ) == "" );
+        EXPECT( first_difference<float >( x, []( float  const * p, float  const * q, float  * o ) { return clamp_range( clamp_nan::to_lo    , p, q, o, 70.f, 20.f, std14::greater<>() ); },
+                                             [&]( std::size_t k ) { return clamp( clamp_nan::to_lo, x[k], 70.f, 20.f, std14::greater<>() ); } ) == "" );
+        EXPECT( first_difference<double>( y, []( double const * p, double const * q, double * o ) { return clamp_range( clamp_nan::to_hi    , p, q, o, 20. , 70.  ); },
+                                             [&]( std::size_t k ) { return clamp( clamp_nan::to_hi    , y[k], 20. , 70.  ); } ) == "" );
+        EXPECT( first_difference<double>( y, []( double const * p, double const * q, double * o ) { return clamp_range( clamp_nan::to_lo    , p, q, o, 70. , 20. , std::greater<double>() ); },
+                                             [&]( std::size_t k ) { return clamp( clamp_nan::to_lo, y[k], 70., 20., std::greater<double>() ); } ) == "" );
+        EXPECT( first_difference<f16   >( h, [&]( f16  const * p, f16  const * q, f16  * o ) { return clamp_range( clamp_nan::to_lo    , p, q, o, h_lo, h_hi ); },
+                                             [&]( std::size_t k ) { return clamp( clamp_nan::to_lo    , h[k], h_lo, h_hi ); } ) == "" );
+        EXPECT( first_difference<f16   >( h, [&]( f16  const * p, f16  const * q, f16  * o ) { return clamp_range( clamp_nan::to_hi    , p, q, o, h_hi, h_lo, std14::greater<>() ); },
+                                             [&]( std::size_t k ) { return clamp( clamp_nan::to_hi, h[k], h_hi, h_lo, std14::greater<>() ); } ) == "" );
+        EXPECT( first_difference<bf16  >( b, [&]( bf16 const * p, bf16 const * q, bf16 * o ) { return clamp_range( clamp_nan::to_hi    , p, q, o, b_lo, b_hi ); },
+                                             [&]( std::size_t k ) { return clamp( clamp_nan::to_hi    , b[k], b_lo, b_hi ); } ) == "" );
+        EXPECT( first_difference<bf16  >( b, [&]( bf16 const * p, bf16 const * q, bf16 * o ) { return clamp_range( clamp_nan::propagate, p, q, o, b_lo, b_hi ); },
+                                             [&]( std::size_t k ) { return clamp( clamp_nan::propagate, b[k], b_lo, b_hi ); } ) == "" );
+    },
+
+    CASE( "clamp_range(policy,...) maps NaN with non-contiguous iterators and leaves integers alone" )
+    {
+        double const nan = std::numeric_limits<double>::quiet_NaN();
+
+        std::list<double> l{ nan, 1, 5, nan, 9, };
+        std::list<double> const c{ 3, 3, 5, 3, 7, };
+
+        std::vector<int>       a{ -7, 1, 5, 9, };
+        std::vector<int> const b{  3, 3, 5, 7, };
+
+        EXPECT( ( clamp_range( clamp_nan::to_lo, l.begin(), l.end(), l.begin(), 3., 7. ) == l.end() ) );
+        EXPECT( ( clamp_range( clamp_nan::to_hi, a.begin(), a.end(), a.begin(), 3, 7 ) == a.end() ) );
+        EXPECT( ( l == c ) );
+        EXPECT( a == b );
+    },
+
+    // clamp<Lo, Hi>( v ), clamp_range<Lo, Hi>( first, last, out ):
+
+    CASE( "clamp<Lo,Hi>(v) is a valid constexpr expression" )
+    {
+        constexpr auto c = clamp<5, 9>( 7 );
+        constexpr auto d = clamp< std::ratio<-1, 2>, std::ratio<1, 2> >( 0.75 );
+        constexpr auto e = clamp< std::integral_constant<int, 0>, std::integral_constant<int, 6> >( 7.5f );
+
+        static_assert( c == 7 && d == 0.5 && e == 6.f, "clamp<Lo,Hi>(v)" );
+        use(c);
+    },
+
+    CASE( "clamp<Lo,Hi>(v) clamps to compile-time bounds, also at the limits of the type" )
+    {
+        EXPECT( ( clamp<0, 255>( 300 ) == 255 ) );
+        EXPECT( ( clamp<0, 255>( -30 ) ==   0 ) );
+        EXPECT( ( clamp<0, 255>( std::uint8_t( 200 ) ) == 200 ) );
+        EXPECT( ( clamp<0, 100>( std::uint8_t( 200 ) ) == 100 ) );
+        EXPECT( ( clamp<-128, 0>( std::int8_t( -100 ) ) == -100 ) );
+        EXPECT( ( clamp<-128, 0>( std::int8_t(  100 ) ) ==    0 ) );
+        EXPECT( ( clamp<-1, 1>( -2.5 ) == -1. ) );
+        EXPECT( ( clamp< std::ratio<4, 2>, std::ratio<10, 1> >( 1 ) == 2 ) );
+        EXPECT( ( clamp< std::ratio<4, 2>, std::ratio<10, 1> >( 7 ) == 7 ) );
+    },
+
+#ifdef CLAMP_ACCEPTS_FRACTIONAL_INTEGRAL_BOUNDS
+
+    // clamp<Lo, Hi>() does not accept a fractional ratio bound for an integral
+    // type, which would truncate to [0, 2] here:
+
+    CASE( "clamp<Lo,Hi>(v) does not compile with a fractional ratio bound for an integral type" )
+    {
+        EXPECT( ( clamp< std::ratio<1, 2>, std::ratio<5, 2> >( 1 ) == 1 ) );
+    },
+#endif
+
+    CASE( "clamp_range<Lo,Hi>() on contiguous arithmetic data agrees with clamp() for all lengths" )
+    {
+        typedef std::int8_t i8; typedef std::uint8_t u8; typedef std::int16_t i16; typedef std::uint16_t u16;
+        typedef std::int32_t i32; typedef std::uint64_t u64;
+
+        auto const a = test_values<i8 >( 100 );
+        auto const b = test_values<u8 >( 100 );
+        auto const c = test_values<i16>( 100 );
+        auto const d = test_values<u16>( 100 );
+        auto const e = test_values<i32>(  50 );
+        auto const g = test_values<u64>(  50 );
+        auto const x = test_values<float >( 50 );
+        auto const y = test_values<double>( 50 );
+
+        EXPECT( first_difference<i8 >( a, []( i8  const * p, i8  const * q, i8  * o ) { return clamp_range<-128,    20>( p, q, o ); },
+                                          [&]( std::size_t k ) { return clamp( a[k], i8 (-128), i8 (   20) ); } ) == "" );
+        EXPECT( first_difference<u8 >( b, []( u8  const * p, u8  const * q, u8  * o ) { return clamp_range<   0,    70>( p, q, o ); },
+                                          [&]( std::size_t k ) { return clamp( b[k], u8 (   0), u8 (   70) ); } ) == "" );
+        EXPECT( first_difference<u8 >( b, []( u8  const * p, u8  const * q, u8  * o ) { return clamp_range<   0,   255>( p, q, o ); },
+                                          [&]( std::size_t k ) { return clamp( b[k], u8 (   0), u8 (  255) ); } ) == "" );
+        EXPECT( first_difference<i16>( c, []( i16 const * p, i16 const * q, i16 * o ) { return clamp_range< -20,    70>( p, q, o ); },
+                                          [&]( std::size_t k ) { return clamp( c[k], i16( -20), i16(   70) ); } ) == "" );
+        EXPECT( first_difference<u16>( d, []( u16 const * p, u16 const * q, u16 * o ) { return clamp_range<  20, 65535>( p, q, o ); },
+                                          [&]( std::size_t k ) { return clamp( d[k], u16(  20), u16(65535) ); } ) == "" );
+        EXPECT( first_difference<i32>( e, []( i32 const * p, i32 const * q, i32 * o ) { return clamp_range<   0,     6>( p, q, o ); },
+                                          [&]( std::size_t k ) { return clamp( e[k], i32(   0), i32(    6) ); } ) == "" );
+        EXPECT( first_difference<u64>( g, []( u64 const * p, u64 const * q, u64 * o ) { return clamp_range<   0,   100>( p, q, o ); },
+                                          [&]( std::size_t k ) { return clamp( g[k], u64(   0), u64(  100) ); } ) == "" );
+        EXPECT( first_difference<float >( x, []( float  const * p, float  const * q, float  * o ) { return clamp_range< 0, 6>( p, q, o ); },
+                                             [&]( std::size_t k ) { return clamp( x[k],  0.f, 6.f ); } ) == "" );
+        EXPECT( first_difference<double>( y, []( double const * p, double const * q, double * o ) { return clamp_range<-1, 1>( p, q, o ); },
+                                             [&]( std::size_t k ) { return clamp( y[k], -1. , 1.  ); } ) == "" );
+    },
+
+    CASE( "clamp_range<Lo,Hi>() clamps with non-contiguous iterators and ratio bounds" )
+    {
+        std::list<double>       l{ -7, 0.25, 9, };
+        std::list<double> const c{ -0.5, 0.25, 0.5, };
+
+        EXPECT( ( clamp_range< std::ratio<-1, 2>, std::ratio<1, 2> >( l.begin(), l.end(), l.begin() ) == l.end() ) );
+        EXPECT( ( l == c ) );
+    },
+
+    // clamped_view( range, lo, hi[, pred] ), clamped_view( first, last, lo, hi[, pred] ):
+
+    CASE( "clamped_view() clamps values on access without changing the range" )
+    {
+        std::vector<int> const a{ -7,1,2,3,4,5,6,7,8,9, };
+        std::vector<int> const b{  3,3,3,3,4,5,6,7,7,7, };
+
+        auto const view = clamped_view( a, 3, 7 );
+
+        EXPECT( view.size() == 10U );
+        EXPECT( view[0] == 3 );
+        EXPECT( view[9] == 7 );
+        EXPECT( std::vector<int>( view.begin(), view.end() ) == b );
+        EXPECT( std::accumulate( view.begin(), view.end(), 0 ) == 48 );
+        EXPECT( ( std::find( view.begin(), view.end(), 7 ) - view.begin() == 7 ) );
+        EXPECT( *std::max_element( view.begin(), view.end() ) == 7 );
+        EXPECT( a[0] == -7 );
+    },
+
+    CASE( "clamped_view() has iterators with the underlying iterator's category and operations" )
+    {
+        std::vector<double> v{ 1, 2, 3, };
+        std::list<double>   l{ 1, 2, 3, };
+
+        auto const vv = clamped_view( v, 0., 1. );
+        auto const lv = clamped_view( l.begin(), l.end(), 3., 2., std14::greater<>() );
+
+        typedef decltype( vv.begin() ) vv_iterator;
+        typedef decltype( lv.begin() ) lv_iterator;
+
+        EXPECT( ( std::is_same<std::iterator_traits<vv_iterator>::iterator_category, std::random_access_iterator_tag>::value ) );
+        EXPECT( ( std::is_same<std::iterator_traits<lv_iterator>::iterator_category, std::bidirectional_iterator_tag>::value ) );
+        EXPECT( ( std::is_same<vv_iterator::iterator_concept, std::random_access_iterator_tag>::value ) );
+        EXPECT( ( std::is_same<lv_iterator::iterator_concept, std::bidirectional_iterator_tag>::value ) );
+        EXPECT( ( std::is_same<std::iterator_traits<vv_iterator>::reference, double>::value ) );
+        EXPECT( ( std::is_same<std::iterator_traits<vv_iterator>::pointer, void>::value ) );
+
+        auto it = vv.end();
+        EXPECT( ( it - vv.begin() == 3 ) );
+        EXPECT( *--it == 1. );
+        EXPECT( ( vv.begin() + 1 < it ) );
+        EXPECT( vv.size() == 3U );
+        EXPECT( lv.size() == 3U );
+        EXPECT( ( std::vector<double>( lv.begin(), lv.end() ) == std::vector<double>{ 2, 2, 3, } ) );
+
+        auto jt = lv.end();
+        EXPECT( *--jt == 3. );
+        EXPECT( ( jt.base() == std::prev( l.end() ) ) );
+        EXPECT( *std::prev( lv.end(), 2 ) == 2. );
+        EXPECT( std::distance( vv.begin(), vv.end() ) == 3 );
+        EXPECT( std::count( lv.begin(), lv.end(), 2. ) == 2 );
+    },
+
+    // make_clamp_output_iterator( out, lo, hi[, pred] ), clamp_copy( first, last, out ):
+
+    CASE( "clamp_output_iterator clamps values assigned to it" )
+    {
+        std::vector<int>          const a{ -7,1,2,3,4,5,6,7,8,9, };
+        std::vector<int>          const b{  3,3,3,3,4,5,6,7,7,7, };
+        std::vector<std::uint8_t> const c{  0,1,2,3,4,5,6,7,8,9, };
+
+        std::vector<int> x;
+        std::list<int>   y;
+        std::vector<std::uint8_t> z( a.size() );
+
+        std::copy( a.begin(), a.end(), make_clamp_output_iterator( std::back_inserter( x ), 3, 7 ) );
+        std::copy( a.begin(), a.end(), make_clamp_output_iterator( std::back_inserter( y ), 7, 3, std14::greater<>() ) );
+
+        auto const out = std::copy( a.begin(), a.end(), make_clamp_output_iterator( z.begin(), 0, 255 ) );
+
+        EXPECT( x == b );
+        EXPECT( ( y == std::list<int>( b.begin(), b.end() ) ) );
+        EXPECT( z == c );
+        EXPECT( ( out.base() == z.end() ) );
+    },
+
+    CASE( "clamp_copy() clamps to a clamp_output_iterator over contiguous storage and copies otherwise" )
+    {
+        std::vector<float> a( 100 );
+        std::iota( a.begin(), a.end(), -50.f );
+
+        std::vector<float> b( a.size() ), c( a.size() ), expect( a.size() );
+        clamp_range( a.begin(), a.end(), expect.begin(), -10.f, 10.f );
+
+        auto const out = clamp_copy( a.begin(), a.end(), make_clamp_output_iterator( b.data(), -10.f, 10.f ) );
+
+        EXPECT( ( out.base() == b.data() + b.size() ) );
+        EXPECT( b == expect );
+        EXPECT( ( clamp_copy( a.begin(), a.end(), c.begin() ) == c.end() ) );
+        EXPECT( c == a );
+    },
+
+    // clamp_range_batch( [policy,] first, last[, pred] ):
+
+    CASE( "clamp_range_batch() clamps each range to its own bounds, in place or to another range" )
+    {
+        std::vector<int> a( 37 ), b( 20 ), c, d{ -3, 3, 9, };
+        std::iota( a.begin(), a.end(), -18 );
+        std::iota( b.begin(), b.end(), 0 );
+
+        std::vector<int> out( b.size(), -1 );
+
+        std::vector<clamp_batch_item<int>> batch{
+            { a.data(), a.data() + a.size(), a.data()  , -5,  5 },
+            { b.data(), b.data() + b.size(), out.data(), 10, 12 },
+            { c.data(), c.data()           , c.data()  ,  0,  0 },
+            { d.data(), d.data() + d.size(), d.data()  ,  0,  5 }, };
+
+        std::vector<float> x{ -2, -1, 0, 1, 2, };
+        std::vector<clamp_batch_item<float>> batch_greater{ { x.data(), x.data() + x.size(), x.data(), 1.f, -1.f }, };
+
+        std::vector<int> const expect_a{ -5,-5,-5,-5,-5,-5,-5,-5,-5,-5,-5,-5,-5,-5, -4,-3,-2,-1,0,1,2,3,4, 5,5,5,5,5,5,5,5,5,5,5,5,5,5, };
+        std::vector<int> const expect_out{ 10,10,10,10,10,10,10,10,10,10,10,11, 12,12,12,12,12,12,12,12, };
+        std::vector<int> const expect_d{ 0, 3, 5, };
+        std::vector<float> const expect_x{ -1, -1, 0, 1, 1, };
+
+        clamp_range_batch( batch.begin(), batch.end() );
+        clamp_range_batch( batch_greater.begin(), batch_greater.end(), std14::greater<>() );
+
+        EXPECT( a   == expect_a   );
+        EXPECT( out == expect_out );
+        EXPECT( b[0]  ==  0 );
+        EXPECT( b[19] == 19 );
+        EXPECT( d   == expect_d   );
+        EXPECT( x   == expect_x   );
+    },
+
+    CASE( "clamp_range_batch(policy,...) clamps a large batch like clamp_range_batch()" )
+    {
+        int const count = 4 * CLAMP_PARALLEL_THRESHOLD / 32;
+
+        std::vector<int> data( 32 * count );
+        for ( std::size_t i = 0; i < data.size(); ++i )
+            data[i] = int( i / 32 + i % 32 ) - 10;
+
+        std::vector<int> seq( data.size() ), par( data.size() ), par_unseq( data.size() );
+        std::vector<clamp_batch_item<int>> batch_seq, batch_par, batch_unseq;
+
+        for ( int k = 0; k < count; ++k )
+        {
+            int const * const first = data.data() + 32 * k;
+
+            batch_seq  .push_back( { first, first + 32, seq      .data() + 32 * k, k, k + 10 } );
+            batch_par  .push_back( { first, first + 32, par      .data() + 32 * k, k, k + 10 } );
+            batch_unseq.push_back( { first, first + 32, par_unseq.data() + 32 * k, k, k + 10 } );
+        }
+
+        clamp_range_batch( batch_seq.begin(), batch_seq.end() );
+        clamp_range_batch( clamp_execution::par      , batch_par  .begin(), batch_par  .end() );
+        clamp_range_batch( clamp_execution::par_unseq, batch_unseq.begin(), batch_unseq.end() );
+
+        EXPECT( seq[ 32 * 10 ] == 10 );
+        EXPECT( seq[ 32 * 10 + 31 ] == 20 );
+        EXPECT( par       == seq );
+        EXPECT( par_unseq == seq );
+    },
+
+    // clamp_range( store_policy, first, last, out, lo, hi[, pred] ):
+
+    CASE( "clamp_range(clamp_store::streaming,...) on contiguous arithmetic data agrees with clamp() for all lengths and offsets" )
+    {
+        typedef std::int8_t i8; typedef std::int16_t i16; typedef std::uint16_t u16; typedef std::int32_t i32; typedef std::uint64_t u64;
+
+        auto const a = test_values<i8 >( 200 );
+        auto const b = test_values<u16>( 100 );
+        auto const c = test_values<i16>( 100 );
+        auto const e = test_values<i32>(  50 );
+        auto const g = test_values<u64>(  50 );
+        auto const x = test_values<float >( 50 );
+        auto const y = test_values<double>( 50 );
+        auto const h = test_values<clamp_half>( 50 );
+
+        clamp_half const h_lo( -50.f ), h_hi( 70.f );
+
+        EXPECT( first_difference<i8 >( a, []( i8  const * p, i8  const * q, i8  * o ) { return clamp_range( clamp_store::streaming, p, q, o, i8 (-50), i8 (70) ); },
+                                          [&]( std::size_t k ) { return clamp( a[k], i8 (-50), i8 (70) ); } ) == "" );
+        EXPECT( first_difference<u16>( b, []( u16 const * p, u16 const * q, u16 * o ) { return clamp_range( clamp_store::streaming, p, q, o, u16( 50), u16(70) ); },
+                                          [&]( std::size_t k ) { return clamp( b[k], u16( 50), u16(70) ); } ) == "" );
+        EXPECT( first_difference<i32>( e, []( i32 const * p, i32 const * q, i32 * o ) { return clamp_range( clamp_store::streaming, p, q, o, i32(-50), i32(70) ); },
+                                          [&]( std::size_t k ) { return clamp( e[k], i32(-50), i32(70) ); } ) == "" );
+        EXPECT( first_difference<u64>( g, []( u64 const * p, u64 const * q, u64 * o ) { return clamp_range( clamp_store::streaming, p, q, o, u64( 50), u64(70) ); },
+                                          [&]( std::size_t k ) { return clamp( g[k], u64( 50), u64(70) ); } ) == "" );
+        EXPECT( first_difference<float >( x, []( float  const * p, float  const * q, float  * o ) { return clamp_range( clamp_store::streaming, p, q, o, -50.f, 70.f ); },
+                                             [&]( std::size_t k ) { return clamp( x[k], -50.f, 70.f ); } ) == "" );
+        EXPECT( first_difference<double>( y, []( double const * p, double const * q, double * o ) { return clamp_range( clamp_store::streaming, p, q, o, -50. , 70.  ); },
+                                             [&]( std::size_t k ) { return clamp( y[k], -50. , 70.  ); } ) == "" );
+        EXPECT( first_difference<clamp_half>( h, [&]( clamp_half const * p, clamp_half const * q, clamp_half * o ) { return clamp_range( clamp_store::streaming, p, q, o, h_lo, h_hi ); },
+                                                 [&]( std::size_t k ) { return clamp( h[k], h_lo, h_hi ); } ) == "" );
+
+        EXPECT( first_difference<i16>( c, []( i16 const * p, i16 const * q, i16 * o ) { return clamp_range( clamp_store::streaming, p, q, o, i16(70), i16(-50), std14::greater<>() ); },
+                                          [&]( std::size_t k ) { return clamp( c[k], i16(70), i16(-50), std14::greater<>() ); } ) == "" );
+        EXPECT( first_difference<double>( y, []( double const * p, double const * q, double * o ) { return clamp_range( clamp_store::streaming, p, q, o, 70. , -50. , std14::greater<>() ); },
+                                             [&]( std::size_t k ) { return clamp( y[k], 70. , -50. , std14::greater<>() ); } ) == "" );
+    },
+
+    CASE( "clamp_range(store_policy,...) clamps like clamp_range() in place and with other iterators" )
+    {
+        std::vector<int> const a{ 1,2,3,4,5,6,7,8,9, };
+        std::vector<int> const b{ 3,3,3,4,5,6,7,7,7, };
+
+        std::vector<int> x( a ), y( a ), z( a.size() );
+        std::list<int>   l( a.begin(), a.end() );
+
+        EXPECT( ( clamp_range( clamp_store::streaming, x.begin(), x.end(), x.begin(), 3, 7 ) == x.end() ) );
+        EXPECT( ( clamp_range( clamp_store::cached   , y.begin(), y.end(), y.begin(), 3, 7 ) == y.end() ) );
+        EXPECT( ( clamp_range( clamp_store::automatic, a.begin(), a.end(), z.begin(), 3, 7 ) == z.end() ) );
+        EXPECT( ( clamp_range( clamp_store::streaming, l.begin(), l.end(), l.begin(), 3, 7 ) == l.end() ) );
+
+        EXPECT( x == b );
+        EXPECT( y == b );
+        EXPECT( z == b );
+        EXPECT( ( l == std::list<int>( b.begin(), b.end() ) ) );
+    },
+
+    // clamp_indexed(), clamp_gather(), clamp_scatter( [policy,] ... ):
+
+    CASE( "clamp_indexed(), clamp_gather() and clamp_scatter() on contiguous data clamp through repeated indices" )
+    {
+        std::vector<std::int32_t> const index32{ 39, 0, 17, 38, 16, 24, 24, 18, 19, 21, 25, 20, 26, 22, 30, 15, 14, 23, 3, 39, };
+        std::vector<std::int64_t> const index64( index32.begin(), index32.end() );
+
+        std::vector<float> data( 40 );
+        std::iota( data.begin(), data.end(), -20.f );
+
+        std::vector<float> const expect_indexed{
+            -5,-19,-18,-5,-16,-15,-14,-13,-12,-11, -10,-9,-8,-7,-5,-5,-4,-3,-2,-1,
+             0,  1,  2, 3,  4,  5,  5,  7,  8,  9,   5,11,12,13,14,15,16,17, 5, 5, };
+        std::vector<float> const expect_gathered{
+             5,-5,-3, 5,-4, 4, 4,-2,-1, 1,  5, 0, 5, 2, 5,-5,-5, 3,-5, 5, };
+        std::vector<float> const expect_scattered{
+            -5,-19,-18,-2,-16,-15,-14,-13,-12,-11, -10,-9,-8,-7,-4,-5,-5,-5,-5,-5,
+            -5, -5, -5,-3, -5, -5, -5,  7,  8,  9,  -5,11,12,13,14,15,16,17,-5,-1, };
+
+        std::vector<float> indexed( data ), gathered( index32.size() ), scattered( data );
+
+        clamp_indexed( indexed.data(), index32.data(), index32.data() + index32.size(), -5.f, 5.f );
+        clamp_scatter( data.data(), data.data() + index32.size(), index32.data(), scattered.data(), -5.f, 5.f );
+
+        EXPECT( ( clamp_gather( data.data(), index32.data(), index32.data() + index32.size(), gathered.data(), -5.f, 5.f ) == gathered.data() + gathered.size() ) );
+        EXPECT( indexed   == expect_indexed );
+        EXPECT( gathered  == expect_gathered );
+        EXPECT( scattered == expect_scattered );
+
+        std::vector<double> const data_d( data.begin(), data.end() );
+        std::vector<double> indexed_d( data_d ), gathered_d( index64.size() ), scattered_d( data_d );
+
+        clamp_indexed( indexed_d.data(), index64.data(), index64.data() + index64.size(), 5., -5., std14::greater<>() );
+        clamp_gather( data_d.data(), index64.data(), index64.data() + index64.size(), gathered_d.data(), 5., -5., std14::greater<>() );
+        clamp_scatter( data_d.data(), data_d.data() + index64.size(), index64.data(), scattered_d.data(), 5., -5., std14::greater<>() );
+
+        EXPECT( indexed_d   == std::vector<double>( expect_indexed.begin()  , expect_indexed.end()   ) );
+        EXPECT( gathered_d  == std::vector<double>( expect_gathered.begin() , expect_gathered.end()  ) );
+        EXPECT( scattered_d == std::vector<double>( expect_scattered.begin(), expect_scattered.end() ) );
+    },
+
+    CASE( "clamp_gather() on contiguous data agrees with clamp() through the indices for all lengths" )
+    {
+        typedef std::int16_t i16; typedef std::int32_t i32; typedef std::uint32_t u32; typedef std::int64_t i64; typedef std::uint64_t u64;
+
+        std::vector<i32> index32;
+        for ( int k = 0; k < 50; ++k )
+            index32.push_back( ( k * 7919 ) % 300 % ( k % 3 ? 300 : 17 ) );
+
+        std::vector<i64> const index64( index32.begin(), index32.end() );
+        std::vector<u32> const indexu32( index32.begin(), index32.end() );
+        std::vector<std::size_t> const indexz( index32.begin(), index32.end() );
+
+        auto const a = test_values<i32>( 300 );
+        auto const b = test_values<u32>( 300 );
+        auto const c = test_values<i16>( 300 );
+        auto const d = test_values<i64>( 300 );
+        auto const e = test_values<u64>( 300 );
+        auto const x = test_values<float >( 300 );
+        auto const y = test_values<double>( 300 );
+
+        EXPECT( first_difference<i32>( index64, [&]( i64 const * p, i64 const * q, i32 * o ) { return clamp_gather( a.data(), p, q, o, -50, 70 ); },
+                                                [&]( std::size_t k ) { return clamp( a[ index32[k] ], -50, 70 ); } ) == "" );
+        EXPECT( first_difference<u32>( index32, [&]( i32 const * p, i32 const * q, u32 * o ) { return clamp_gather( b.data(), p, q, o, 50U, 70U ); },
+                                                [&]( std::size_t k ) { return clamp( b[ index32[k] ], 50U, 70U ); } ) == "" );
+        EXPECT( first_difference<i16>( index32, [&]( i32 const * p, i32 const * q, i16 * o ) { return clamp_gather( c.data(), p, q, o, i16(-50), i16(70) ); },
+                                                [&]( std::size_t k ) { return clamp( c[ index32[k] ], i16(-50), i16(70) ); } ) == "" );
+        EXPECT( first_difference<i64>( index32, [&]( i32 const * p, i32 const * q, i64 * o ) { return clamp_gather( d.data(), p, q, o, i64(-50), i64(70) ); },
+                                                [&]( std::size_t k ) { return clamp( d[ index32[k] ], i64(-50), i64(70) ); } ) == "" );
+        EXPECT( first_difference<u64>( indexz , [&]( std::size_t const * p, std::size_t const * q, u64 * o ) { return clamp_gather( e.data(), p, q, o, u64(50), u64(70) ); },
+                                                [&]( std::size_t k ) { return clamp( e[ index32[k] ], u64(50), u64(70) ); } ) == "" );
+        EXPECT( first_difference<float>( index32, [&]( i32 const * p, i32 const * q, float * o ) { return clamp_gather( x.data(), p, q, o, -50.f, 70.f ); },
+                                                  [&]( std::size_t k ) { return clamp( x[ index32[k] ], -50.f, 70.f ); } ) == "" );
+        EXPECT( first_difference<float>( indexz , [&]( std::size_t const * p, std::size_t const * q, float * o ) { return clamp_gather( x.data(), p, q, o, 70.f, -50.f, std14::greater<>() ); },
+                                                  [&]( std::size_t k ) { return clamp( x[ index32[k] ], 70.f, -50.f, std14::greater<>() ); } ) == "" );
+        EXPECT( first_difference<double>( index64, [&]( i64 const * p, i64 const * q, double * o ) { return clamp_gather( y.data(), p, q, o, -50., 70. ); },
+                                                   [&]( std::size_t k ) { return clamp( y[ index32[k] ], -50., 70. ); } ) == "" );
+        EXPECT( first_difference<double>( indexu32, [&]( u32 const * p, u32 const * q, double * o ) { return clamp_gather( y.data(), p, q, o, -50., 70. ); },
+                                                    [&]( std::size_t k ) { return clamp( y[ index32[k] ], -50., 70. ); } ) == "" );
+    },
+
+    CASE( "clamp_indexed(), clamp_gather() and clamp_scatter() accept other iterators" )
+    {
+        std::vector<int>  const a{ 1,2,3,4,5,6,7,8,9, };
+        std::list<short>  const index{ 8,0,4, };
+
+        std::vector<int> x( a ), y( a.size() ), z( a );
+        std::list<int>   g;
+
+        clamp_indexed( x.begin(), index.begin(), index.end(), 3, 7 );
+        clamp_gather( a.begin(), index.begin(), index.end(), std::back_inserter( g ), 3, 7 );
+        clamp_scatter( a.rbegin(), a.rbegin() + 3, index.begin(), z.begin(), 3, 7 );
+
+        EXPECT( ( x == std::vector<int>{ 3,2,3,4,5,6,7,8,7, } ) );
+        EXPECT( ( g == std::list<int>{ 7,3,5, } ) );
+        EXPECT( ( z == std::vector<int>{ 7,2,3,4,7,6,7,8,7, } ) );
+    },
+
+    CASE( "clamp_indexed(policy,...), clamp_gather(policy,...) and clamp_scatter(policy,...) agree with the sequential versions" )
+    {
+        std::size_t const n = 2 * CLAMP_PARALLEL_THRESHOLD;
+
+        std::vector<float> data( 2 * n );
+        std::iota( data.begin(), data.end(), -1.e5f );
+
+        std::vector<std::int32_t> index( n );
+        for ( std::size_t k = 0; k < n; ++k )
+            index[k] = static_cast<std::int32_t>( ( k * 2654435761u ) % ( 2 * n ) );
+        std::sort( index.begin(), index.end() );
+        index.erase( std::unique( index.begin(), index.end() ), index.end() );
+
+        std::vector<float> in_place( data ), in_place_par( data );
+        std::vector<float> gathered( index.size() ), gathered_par( index.size() );
+        std::vector<float> scattered( data ), scattered_par( data );
+
+        clamp_indexed( in_place.begin(), index.begin(), index.end(), 0.f, 1.e5f );
+        clamp_gather( data.begin(), index.begin(), index.end(), gathered.begin(), 0.f, 1.e5f );
+        clamp_scatter( data.begin(), data.begin() + index.size(), index.begin(), scattered.begin(), 0.f, 1.e5f );
+
+        clamp_indexed( clamp_execution::par, in_place_par.begin(), index.begin(), index.end(), 0.f, 1.e5f );
+        clamp_gather( clamp_execution::par, data.begin(), index.begin(), index.end(), gathered_par.begin(), 0.f, 1.e5f );
+        clamp_scatter( clamp_execution::par_unseq, data.begin(), data.begin() + index.size(), index.begin(), scattered_par.begin(), 0.f, 1.e5f );
+
+        EXPECT( in_place_par  == in_place );
+        EXPECT( gathered_par  == gathered );
+        EXPECT( scattered_par == scattered );
+    },
+
+    // clamp_sorted_range( first, last, out, lo, hi[, pred] ):
+
+    CASE( "clamp_sorted_range() agrees with clamp_range() on sorted data" )
+    {
+        std::vector<int> a( 200 );
+        for ( std::size_t i = 0; i < a.size(); ++i )
+            a[i] = int( i / 3 ) - 30;
+
+        for ( int lo = -40; lo <= 80; lo += 7 )
+        {
+            for ( int hi = lo; hi <= 80; hi += 11 )
+            {
+                std::vector<int> expect( a.size() ), out( a.size() ), in_place( a );
+                clamp_range( a.begin(), a.end(), expect.begin(), lo, hi );
+
+                EXPECT( ( clamp_sorted_range( a.begin(), a.end(), out.begin(), lo, hi ) == out.end() ) );
+                EXPECT( ( clamp_sorted_range( in_place.data(), in_place.data() + a.size(), in_place.data(), lo, hi ) == in_place.data() + a.size() ) );
+                EXPECT( out == expect );
+                EXPECT( in_place == expect );
+            }
+        }
+    },
+
+    CASE( "clamp_sorted_range() clamps per predicate with other iterators" )
+    {
+        std::list<double> a{ 9,8,7,6,5,4,3,2,1, };
+        std::list<double> const b{ 7,7,7,6,5,4,3,3,3, };
+
+        std::vector<double> out;
+
+        clamp_sorted_range( a.begin(), a.end(), std::back_inserter( out ), 7., 3., std14::greater<>() );
+        clamp_sorted_range( a.begin(), a.end(), a.begin(), 7., 3., std14::greater<>() );
+
+        EXPECT( a == b );
+        EXPECT( ( out == std::vector<double>( b.begin(), b.end() ) ) );
+    },
+
+    CASE( "clamp_sorted_range() in place writes only the values that change" )
+    {
+        struct counted
+        {
+            counted( int v = 0 ) : v( v ) {}
+            counted( counted const & other ) : v( other.v ) {}
+            counted & operator=( counted const & other ) { v = other.v; ++writes(); return *this; }
+            bool operator<( counted const & other ) const { return v < other.v; }
+            static int & writes() { static int n = 0; return n; }
+            int v;
+        };
+
+        std::vector<counted> a;
+        for ( int i = 0; i < 1000; ++i )
+            a.push_back( counted( i ) );
+
+        counted::writes() = 0;
+        clamp_sorted_range( a.begin(), a.end(), a.begin(), counted( 3 ), counted( 990 ) );
+
+        EXPECT( counted::writes() == 3 + 9 );
+        EXPECT( a[0].v == 3 );
+        EXPECT( a[999].v == 990 );
+    },
+
+    // clamp_range( clamp_store::changed, first, last, out, lo, hi[, pred] ):
+
+    CASE( "clamp_range(clamp_store::changed,...) on contiguous arithmetic data agrees with clamp() for all lengths" )
+    {
+        typedef std::int8_t i8; typedef std::int16_t i16; typedef std::uint16_t u16; typedef std::int32_t i32; typedef std::uint64_t u64;
+
+        auto const a = test_values<i8 >( 200 );
+        auto const b = test_values<u16>( 100 );
+        auto const c = test_values<i16>( 100 );
+        auto const e = test_values<i32>(  50 );
+        auto const g = test_values<u64>(  50 );
+        auto const x = test_values<float >( 50 );
+        auto const y = test_values<double>( 50 );
+        auto const z = test_values<long double>( 50 );
+        auto const h = test_values<clamp_half>( 50 );
+
+        clamp_half const h_lo( -50.f ), h_hi( 70.f );
+
+        EXPECT( first_difference<i8 >( a, []( i8  const * p, i8  const * q, i8  * o ) { return clamp_range( clamp_store::changed, p, q, o, i8 (-50), i8 (70) ); },
+                                          [&]( std::size_t k ) { return clamp( a[k], i8 (-50), i8 (70) ); } ) == "" );
+        EXPECT( first_difference<u16>( b, []( u16 const * p, u16 const * q, u16 * o ) { return clamp_range( clamp_store::changed, p, q, o, u16( 50), u16(70) ); },
+                                          [&]( std::size_t k ) { return clamp( b[k], u16( 50), u16(70) ); } ) == "" );
+        EXPECT( first_difference<i32>( e, []( i32 const * p, i32 const * q, i32 * o ) { return clamp_range( clamp_store::changed, p, q, o, i32(-50), i32(70) ); },
+                                          [&]( std::size_t k ) { return clamp( e[k], i32(-50), i32(70) ); } ) == "" );
+        EXPECT( first_difference<u64>( g, []( u64 const * p, u64 const * q, u64 * o ) { return clamp_range( clamp_store::changed, p, q, o, u64( 50), u64(70) ); },
+                                          [&]( std::size_t k ) { return clamp( g[k], u64( 50), u64(70) ); } ) == "" );
+        EXPECT( first_difference<float >( x, []( float  const * p, float  const * q, float  * o ) { return clamp_range( clamp_store::changed, p, q, o, -50.f, 70.f ); },
+                                             [&]( std::size_t k ) { return clamp( x[k], -50.f, 70.f ); } ) == "" );
+        EXPECT( first_difference<double>( y, []( double const * p, double const * q, double * o ) { return clamp_range( clamp_store::changed, p, q, o, -50. , 70.  ); },
+                                             [&]( std::size_t k ) { return clamp( y[k], -50. , 70.  ); } ) == "" );
+        EXPECT( first_difference<long double>( z, []( long double const * p, long double const * q, long double * o ) { return clamp_range( clamp_store::changed, p, q, o, -50.L, 70.L ); },
+                                                  [&]( std::size_t k ) { return clamp( z[k], -50.L, 70.L ); } ) == "" );
+        EXPECT( first_difference<clamp_half>( h, [&]( clamp_half const * p, clamp_half const * q, clamp_half * o ) { return clamp_range( clamp_store::changed, p, q, o, h_lo, h_hi ); },
+                                                 [&]( std::size_t k ) { return clamp( h[k], h_lo, h_hi ); } ) == "" );
+
+        EXPECT( first_difference<i16>( c, []( i16 const * p, i16 const * q, i16 * o ) { return clamp_range( clamp_store::changed, p, q, o, i16(70), i16(-50), std14::greater<>() ); },
+                                          [&]( std::size_t k ) { return clamp( c[k], i16(70), i16(-50), std14::greater<>() ); } ) == "" );
+        EXPECT( first_difference<double>( y, []( double const * p, double const * q, double * o ) { return clamp_range( clamp_store::changed, p, q, o, 70. , -50. , std14::greater<>() ); },
+                                             [&]( std::size_t k ) { return clamp( y[k], 70. , -50. , std14::greater<>() ); } ) == "" );
+    },
+
+    CASE( "clamp_range(clamp_store::changed,...) in place writes only the values that change" )
+    {
+        struct counted
+        {
+            counted( int v = 0 ) : v( v ) {}
+            counted( counted const & other ) : v( other.v ) {}
+            counted & operator=( counted const & other ) { v = other.v; ++writes(); return *this; }
+            bool operator<( counted const & other ) const { return v < other.v; }
+            static int & writes() { static int n = 0; return n; }
+            int v;
+        };
+
+        std::list<counted> a;
+        for ( int i = 0; i < 100; ++i )
+            a.push_back( counted( ( i * 37 ) % 100 ) );
+
+        std::vector<counted> b( a.size() );
+
+        counted::writes() = 0;
+        clamp_range( clamp_store::changed, a.begin(), a.end(), a.begin(), counted( 3 ), counted( 90 ) );
+
+        EXPECT( counted::writes() == 3 + 9 );
+
+        counted::writes() = 0;
+        clamp_range( clamp_store::changed, a.begin(), a.end(), b.begin(), counted( 3 ), counted( 90 ) );
+
+        EXPECT( counted::writes() == 100 );
+        EXPECT( std::all_of( b.begin(), b.end(), []( counted const & x ) { return 3 <= x.v && x.v <= 90; } ) );
+    },
+
+    // clamp_range() in place and with move iterators:
+
+    CASE( "clamp_range() in place assigns only the values out of range" )
+    {
+        struct counted
+        {
+            counted( int v = 0 ) : v( v ) {}
+            counted( counted const & other ) : v( other.v ) {}
+            counted & operator=( counted const & other ) { v = other.v; ++writes(); return *this; }
+            bool operator<( counted const & other ) const { return v < other.v; }
+            static int & writes() { static int n = 0; return n; }
+            int v;
+        };
+
+        std::vector<counted> a;
+        for ( int i = 0; i < 100; ++i )
+            a.push_back( counted( ( i * 37 ) % 100 ) );
+
+        counted::writes() = 0;
+        clamp_range( a.begin(), a.end(), a.begin(), counted( 3 ), counted( 90 ) );
+
+        EXPECT( counted::writes() == 3 + 9 );
+
+        counted::writes() = 0;
+        clamp_range( std::make_move_iterator( a.begin() ), std::make_move_iterator( a.end() ), a.begin(), counted( 5 ), counted( 90 ) );
+
+        EXPECT( counted::writes() == 4 + 1 );
+        EXPECT( std::all_of( a.begin(), a.end(), []( counted const & x ) { return 5 <= x.v && x.v <= 90; } ) );
+    },
+
+    CASE( "clamp_range() and clamp_sorted_range() in place accept proxy iterators of non-arithmetic values" )
+    {
+        struct string_ref
+        {
+            std::string * p;
+            string_ref & operator=( std::string const & s ) { *p = s; return *this; }
+            string_ref & operator=( string_ref const & other ) { *p = *other.p; return *this; }
+        };
+
+        struct less_text
+        {
+            bool operator()( string_ref  const & x, std::string const & y ) const { return *x.p < y; }
+            bool operator()( std::string const & x, string_ref  const & y ) const { return x < *y.p; }
+            bool operator()( std::string const & x, std::string const & y ) const { return x < y; }
+        };
+
+        struct proxy_iterator
+        {
+            typedef std::forward_iterator_tag iterator_category;
+            typedef std::string    value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef void           pointer;
+            typedef string_ref     reference;
+
+            std::string * p;
+            string_ref operator*() const { return string_ref{ p }; }
+            proxy_iterator & operator++() { ++p; return *this; }
+            proxy_iterator   operator++( int ) { proxy_iterator tmp( *this ); ++p; return tmp; }
+            bool operator==( proxy_iterator const & other ) const { return p == other.p; }
+            bool operator!=( proxy_iterator const & other ) const { return p != other.p; }
+        };
+
+        std::vector<std::string> a{ "a", "d", "b", "f", "c", };
+        std::vector<std::string> s{ "a", "b", "c", "d", "f", };
+
+        proxy_iterator const a_first{ a.data() }, a_last{ a.data() + a.size() };
+        proxy_iterator const s_first{ s.data() }, s_last{ s.data() + s.size() };
+
+        EXPECT( ( clamp_range( a_first, a_last, a_first, std::string( "b" ), std::string( "d" ), less_text() ) == a_last ) );
+        EXPECT( ( clamp_sorted_range( s_first, s_last, s_first, std::string( "b" ), std::string( "d" ), less_text() ) == s_last ) );
+
+        EXPECT( ( a == std::vector<std::string>{ "b", "d", "b", "d", "c", } ) );
+        EXPECT( ( s == std::vector<std::string>{ "b", "b", "c", "d", "d", } ) );
+    },
+
+    CASE( "clamp_range() with move iterators moves the values in range" )
+    {
+        struct counted
+        {
+            counted( int v = 0 ) : v( v ) {}
+            counted( counted const & other ) : v( other.v ) {}
+            counted & operator=( counted const & other ) { v = other.v; ++copies(); return *this; }
+            counted & operator=( counted && other ) { v = other.v; other.v = -1; ++moves(); return *this; }
+            bool operator<( counted const & other ) const { return v < other.v; }
+            static int & copies() { static int n = 0; return n; }
+            static int & moves()  { static int n = 0; return n; }
+            int v;
+        };
+
+        std::list<counted> a;
+        for ( int i = 0; i < 100; ++i )
+            a.push_back( counted( ( i * 37 ) % 100 ) );
+
+        std::vector<counted> b( a.size() );
+
+        counted::copies() = counted::moves() = 0;
+        clamp_range( std::make_move_iterator( a.begin() ), std::make_move_iterator( a.end() ), b.begin(), counted( 3 ), counted( 90 ) );
+
+        EXPECT( counted::copies() == 3 + 9 );
+        EXPECT( counted::moves()  == 100 - 3 - 9 );
+        EXPECT( std::count_if( a.begin(), a.end(), []( counted const & x ) { return x.v == -1; } ) == 100 - 3 - 9 );
+        EXPECT( std::all_of( b.begin(), b.end(), []( counted const & x ) { return 3 <= x.v && x.v <= 90; } ) );
+    },
+
+    // clamp_range_projected( [policy,] first, last, lo, hi, proj[, pred] ):
+
+    CASE( "clamp_range_projected() clamps a member of contiguous records and leaves the other members alone" )
+    {
+        std::vector<point3> p( 20 );
+        std::vector<point2> q( 20 );
+        for ( int i = 0; i < 20; ++i )
+        {
+            p[i] = point3{ float( i - 10 ), float( 100 + i ), float( 200 + i ) };
+            q[i] = point2{ float( 100 + i ), float( i - 10 ) };
+        }
+
+        EXPECT( ( clamp_range_projected( p.begin(), p.end(), -5.f, 5.f, &point3::x ) == p.end() ) );
+        EXPECT( ( clamp_range_projected( q.data(), q.data() + q.size(), 5.f, -5.f, &point2::y, std14::greater<>() ) == q.data() + q.size() ) );
+
+        std::vector<float> const expect{ -5,-5,-5,-5,-5,-5,-4,-3,-2,-1, 0,1,2,3,4,5,5,5,5,5, };
+        std::vector<float> px, py, pz, qx, qy;
+        for ( int i = 0; i < 20; ++i )
+        {
+            px.push_back( p[i].x ); py.push_back( p[i].y - 100 ); pz.push_back( p[i].z - 200 );
+            qx.push_back( q[i].x - 100 ); qy.push_back( q[i].y );
+        }
+
+        std::vector<float> index( 20 );
+        std::iota( index.begin(), index.end(), 0.f );
+
+        EXPECT( px == expect );
+        EXPECT( qy == expect );
+        EXPECT( py == index );
+        EXPECT( pz == index );
+        EXPECT( qx == index );
+    },
+
+    CASE( "clamp_range_projected() on contiguous records agrees with clamp() for all lengths" )
+    {
+        std::size_t const n = 100;
+
+        std::vector<sample> s( n );
+        std::vector<order>  o( n );
+        std::vector<pixel>  c( n );
+
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            for ( int k = 0; k < 6; ++k )
+                s[i].a[k] = float( 6 * i + k );
+            s[i].v = float( int( i * 37 ) % 251 - 125 );
+            o[i] = order{ std::int64_t( i ), double( int( i * 37 ) % 251 - 125 ), std::int32_t( i ) * -3 };
+            c[i] = pixel{ std::uint8_t( i ), std::uint8_t( i * 37 ), std::uint8_t( 255 - i ), std::uint8_t( 3 * i ) };
+        }
+
+        for ( std::size_t len = 0; len <= n; ++len )
+        {
+            std::vector<sample> t( s );
+            std::vector<order>  u( o );
+            std::vector<pixel>  d( c );
+
+            clamp_range_projected( t.begin(), t.begin() + len, -50.f, 70.f, &sample::v );
+            clamp_range_projected( u.begin(), u.begin() + len, 70.0, -50.0, &order::price, std14::greater<>() );
+            clamp_range_projected( d.begin(), d.begin() + len, std::uint8_t( 50 ), std::uint8_t( 200 ), &pixel::g );
+
+            std::vector<float>  v, expect_v;
+            std::vector<double> price, expect_price;
+            std::vector<int>    g, expect_g;
+            std::vector<double> rest, expect_rest;
+
+            for ( std::size_t i = 0; i < n; ++i )
+            {
+                bool const clamped = i < len;
+
+                v    .push_back( t[i].v );
+                price.push_back( u[i].price );
+                g    .push_back( d[i].g );
+
+                expect_v    .push_back( clamped ? clamp( s[i].v, -50.f, 70.f ) : s[i].v );
+                expect_price.push_back( clamped ? clamp( o[i].price, 70.0, -50.0, std14::greater<>() ) : o[i].price );
+                expect_g    .push_back( clamped ? clamp( c[i].g, std::uint8_t( 50 ), std::uint8_t( 200 ) ) : c[i].g );
+
+                for ( int k = 0; k < 6; ++k )
+                {
+                    rest       .push_back( t[i].a[k] );
+                    expect_rest.push_back( s[i].a[k] );
+                }
+                rest       .insert( rest       .end(), { double( u[i].id ), double( u[i].qty ), double( d[i].r ), double( d[i].b ), double( d[i].a ) } );
+                expect_rest.insert( expect_rest.end(), { double( o[i].id ), double( o[i].qty ), double( c[i].r ), double( c[i].b ), double( c[i].a ) } );
+            }
+
+            EXPECT( v     == expect_v     );
+            EXPECT( price == expect_price );
+            EXPECT( g     == expect_g     );
+            EXPECT( rest  == expect_rest  );
+        }
+    },
+
+    CASE( "clamp_range_projected() clamps through a callable projection and non-contiguous iterators" )
+    {
+        struct item
+        {
+            std::string name;
+            int rank;
+        };
+
+        std::list<item> a{ { "d", 4 }, { "a", 1 }, { "z", 26 }, { "m", 13 }, };
+
+        EXPECT( ( clamp_range_projected( a.begin(), a.end(), 2, 20, &item::rank ) == a.end() ) );
+        EXPECT( ( clamp_range_projected( a.begin(), a.end(), std::string( "b" ), std::string( "k" ),
+            []( item & x ) -> std::string & { return x.name; } ) == a.end() ) );
+
+        std::vector<std::string> names;
+        std::vector<int> ranks;
+        for ( auto const & x : a )
+        {
+            names.push_back( x.name );
+            ranks.push_back( x.rank );
+        }
+
+        EXPECT( ( names == std::vector<std::string>{ "d", "b", "k", "k", } ) );
+        EXPECT( ( ranks == std::vector<int>{ 4, 2, 20, 13, } ) );
+    },
+
+    CASE( "clamp_range_projected(policy,...) clamps a large range like clamp_range_projected()" )
+    {
+        std::vector<order> a( 3 * CLAMP_PARALLEL_THRESHOLD + 17 );
+        for ( std::size_t i = 0; i < a.size(); ++i )
+            a[i] = order{ std::int64_t( i ), double( i % 1000 ) - 500, std::int32_t( i % 300 ) };
+
+        std::vector<order> seq( a ), par( a ), par_unseq( a );
+
+        EXPECT( ( clamp_range_projected( clamp_execution::seq      , seq.begin()      , seq.end()      , -50.0, 70.0, &order::price ) == seq.end()       ) );
+        EXPECT( ( clamp_range_projected( clamp_execution::par      , par.begin()      , par.end()      , -50.0, 70.0, &order::price ) == par.end()       ) );
+        EXPECT( ( clamp_range_projected( clamp_execution::par_unseq, par_unseq.begin(), par_unseq.end(), 70.0, -50.0, &order::price, std14::greater<>() ) == par_unseq.end() ) );
+
+        std::vector<double> expect, seq_price, par_price, par_unseq_price;
+        std::vector<std::int64_t> rest, par_rest;
+        for ( std::size_t i = 0; i < a.size(); ++i )
+        {
+            expect         .push_back( clamp( a[i].price, -50.0, 70.0 ) );
+            seq_price      .push_back( seq[i].price );
+            par_price      .push_back( par[i].price );
+            par_unseq_price.push_back( par_unseq[i].price );
+            rest           .insert( rest    .end(), { a  [i].id, a  [i].qty } );
+            par_rest       .insert( par_rest.end(), { par[i].id, par[i].qty } );
+        }
+
+        EXPECT( seq_price       == expect );
+        EXPECT( par_price       == expect );
+        EXPECT( par_unseq_price == expect );
+        EXPECT( par_rest        == rest );
+    },
+
+    // clamp_points( [policy,] first, last, out, box[, pred] ), clamp_points( [policy,] axes, n, box[, pred] ):
+
+    CASE( "clamp_points() on contiguous AoS points agrees with clamp() per coordinate for all lengths" )
+    {
+        std::size_t const n = 100;
+
+        std::vector<point2> a( n );
+        std::vector<point3> b( n );
+        std::vector<std::array<double, 3>> c( n );
+        std::vector<std::array<std::int16_t, 4>> d( n );
+        std::vector<pixel> e( n );
+
+        auto const v = test_values<int>( int( 4 * n ) );
+
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            a[i] = point2{ float( v[4*i] ), float( v[4*i+1] ) };
+            b[i] = point3{ float( v[4*i] ), float( v[4*i+1] ), float( v[4*i+2] ) };
+            c[i] = std::array<double, 3>{ double( v[4*i] ), double( v[4*i+1] ), double( v[4*i+2] ) };
+            d[i] = std::array<std::int16_t, 4>{ std::int16_t( v[4*i] ), std::int16_t( v[4*i+1] ), std::int16_t( v[4*i+2] ), std::int16_t( v[4*i+3] ) };
+            e[i] = pixel{ std::uint8_t( v[4*i] ), std::uint8_t( v[4*i+1] ), std::uint8_t( v[4*i+2] ), std::uint8_t( v[4*i+3] ) };
+        }
+
+        clamp_box<float, 2> const box_a{ { -50.f, -20.f }, { 70.f, 30.f } };
+        clamp_box<float, 3> const box_b{ { 70.f, 30.f, 10.f }, { -50.f, -20.f, 0.f } };
+        clamp_box<double, 3> const box_c{ { -50, -20, 0 }, { 70, 30, 10 } };
+        clamp_box<std::int16_t, 4> const box_d{ { -50, -20, 0, 5 }, { 70, 30, 10, 5 } };
+        clamp_box<std::uint8_t, 4> const box_e{ { 16, 16, 16, 0 }, { 235, 240, 240, 255 } };
+
+        std::vector<float> expect_a, expect_b;
+        std::vector<double> expect_c;
+        std::vector<std::int16_t> expect_d;
+        std::vector<std::uint8_t> expect_e;
+
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            expect_a.push_back( clamp( a[i].x, box_a.lo[0], box_a.hi[0] ) );
+            expect_a.push_back( clamp( a[i].y, box_a.lo[1], box_a.hi[1] ) );
+            expect_b.push_back( clamp( b[i].x, box_b.lo[0], box_b.hi[0], std14::greater<>() ) );
+            expect_b.push_back( clamp( b[i].y, box_b.lo[1], box_b.hi[1], std14::greater<>() ) );
+            expect_b.push_back( clamp( b[i].z, box_b.lo[2], box_b.hi[2], std14::greater<>() ) );
+
+            for ( std::size_t k = 0; k < 3; ++k )
+                expect_c.push_back( clamp( c[i][k], box_c.lo[k], box_c.hi[k] ) );
+            for ( std::size_t k = 0; k < 4; ++k )
+                expect_d.push_back( clamp( d[i][k], box_d.lo[k], box_d.hi[k] ) );
+
+            expect_e.insert( expect_e.end(), {
+                clamp( e[i].r, box_e.lo[0], box_e.hi[0] ), clamp( e[i].g, box_e.lo[1], box_e.hi[1] ),
+                clamp( e[i].b, box_e.lo[2], box_e.hi[2] ), clamp( e[i].a, box_e.lo[3], box_e.hi[3] ) } );
+        }
+
+        for ( std::size_t len = 0; len <= n; ++len )
+        {
+            std::vector<point2> out_a( len );
+            std::vector<point3> out_b( b.begin(), b.begin() + len );
+            std::vector<std::array<double, 3>> out_c( len );
+            std::vector<std::array<std::int16_t, 4>> out_d( d.begin(), d.begin() + len );
+            std::vector<pixel> out_e( len );
+
+            EXPECT( ( clamp_points( a.begin(), a.begin() + len, out_a.begin(), box_a ) == out_a.end() ) );
+            EXPECT( ( clamp_points( out_b.begin(), out_b.end(), out_b.begin(), box_b, std14::greater<>() ) == out_b.end() ) );
+            EXPECT( ( clamp_points( c.begin(), c.begin() + len, out_c.begin(), box_c ) == out_c.end() ) );
+            EXPECT( ( clamp_points( out_d.begin(), out_d.end(), out_d.begin(), box_d ) == out_d.end() ) );
+            EXPECT( ( clamp_points( e.begin(), e.begin() + len, out_e.begin(), box_e ) == out_e.end() ) );
+
+            EXPECT( coordinates<float       >( out_a ) == std::vector<float       >( expect_a.begin(), expect_a.begin() + 2 * len ) );
+            EXPECT( coordinates<float       >( out_b ) == std::vector<float       >( expect_b.begin(), expect_b.begin() + 3 * len ) );
+            EXPECT( coordinates<double      >( out_c ) == std::vector<double      >( expect_c.begin(), expect_c.begin() + 3 * len ) );
+            EXPECT( coordinates<std::int16_t>( out_d ) == std::vector<std::int16_t>( expect_d.begin(), expect_d.begin() + 4 * len ) );
+            EXPECT( coordinates<std::uint8_t>( out_e ) == std::vector<std::uint8_t>( expect_e.begin(), expect_e.begin() + 4 * len ) );
+        }
+    },
+
+    CASE( "clamp_points() clamps AoS points with non-contiguous iterators" )
+    {
+        std::list<point3> a{ { -2.f, 0.5f, 9.f }, { 0.f, 3.f, -1.f }, };
+
+        EXPECT( ( clamp_points( a.begin(), a.end(), a.begin(), clamp_box<float, 3>{ { -1.f, 0.f, 0.f }, { 1.f, 2.f, 4.f } } ) == a.end() ) );
+
+        EXPECT( a.front().x == -1.f ); EXPECT( a.front().y == 0.5f ); EXPECT( a.front().z == 4.f );
+        EXPECT( a.back().x  ==  0.f ); EXPECT( a.back().y  == 2.f  ); EXPECT( a.back().z  == 0.f );
+    },
+
+    CASE( "clamp_points() on SoA points clamps each axis to its bounds" )
+    {
+        std::vector<float> x( 1000 ), y( 1000 ), z( 1000 );
+        for ( int i = 0; i < 1000; ++i )
+        {
+            x[i] = float( i % 200 - 100 ); y[i] = float( i % 50 - 25 ); z[i] = float( i % 7 );
+        }
+
+        std::vector<float> expect_x, expect_y, expect_z;
+        for ( int i = 0; i < 1000; ++i )
+        {
+            expect_x.push_back( clamp( x[i], -50.f, 50.f ) );
+            expect_y.push_back( clamp( y[i], -10.f, 10.f ) );
+            expect_z.push_back( clamp( z[i],   1.f,  5.f ) );
+        }
+
+        clamp_box<float, 3> const box{ { -50.f, -10.f, 1.f }, { 50.f, 10.f, 5.f } };
+
+        clamp_points( std::array<float *, 3>{ x.data(), y.data(), z.data() }, x.size(), box );
+
+        EXPECT( x[0] == -50.f );
+        EXPECT( x[199] == 50.f );
+        EXPECT( z[0] == 1.f );
+        EXPECT( x == expect_x );
+        EXPECT( y == expect_y );
+        EXPECT( z == expect_z );
+    },
+
+    CASE( "clamp_points(policy,...) clamps many AoS and SoA points like clamp_points()" )
+    {
+        std::size_t const n = 3 * CLAMP_PARALLEL_THRESHOLD + 17;
+
+        std::vector<point3> a( n );
+        std::vector<float> x( n ), y( n ), z( n );
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            a[i] = point3{ float( i % 200 ) - 100, float( i % 50 ) - 25, float( i % 7 ) };
+            x[i] = a[i].x; y[i] = a[i].y; z[i] = a[i].z;
+        }
+
+        clamp_box<float, 3> const box{ { -50.f, -10.f, 1.f }, { 50.f, 10.f, 5.f } };
+
+        std::vector<float> expect, expect_x, expect_y, expect_z;
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            expect_x.push_back( clamp( a[i].x, -50.f, 50.f ) );
+            expect_y.push_back( clamp( a[i].y, -10.f, 10.f ) );
+            expect_z.push_back( clamp( a[i].z,   1.f,  5.f ) );
+            expect.insert( expect.end(), { expect_x.back(), expect_y.back(), expect_z.back() } );
+        }
+
+        std::vector<point3> seq( n ), par( n ), par_unseq( a );
+
+        EXPECT( ( clamp_points( clamp_execution::seq      , a.begin()        , a.end()        , seq.begin()      , box ) == seq.end()       ) );
+        EXPECT( ( clamp_points( clamp_execution::par      , a.begin()        , a.end()        , par.begin()      , box ) == par.end()       ) );
+        EXPECT( ( clamp_points( clamp_execution::par_unseq, par_unseq.begin(), par_unseq.end(), par_unseq.begin(), box ) == par_unseq.end() ) );
+
+        clamp_points( clamp_execution::par, std::array<float *, 3>{ x.data(), y.data(), z.data() }, n, box );
+
+        EXPECT( coordinates<float>( seq       ) == expect );
+        EXPECT( coordinates<float>( par       ) == expect );
+        EXPECT( coordinates<float>( par_unseq ) == expect );
+        EXPECT( x == expect_x );
+        EXPECT( y == expect_y );
+        EXPECT( z == expect_z );
+    },
 };
 
 int main( int argc, char * argv[] )
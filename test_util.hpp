@@ -10,6 +10,7 @@
 #include "std14.hpp"
 
 #include <cmath>
+#include <limits>
 #include <sstream>
 #include <vector>
 